@@ -1,57 +1,92 @@
 #version 330
 
+// Effects are switched on by FX_* defines that postfx.cpp inserts after the
+// #version line, one compiled variant per combination.
+//
+// Everything that doesn't change per frame comes from lookup textures built
+// once in postfx.cpp, so the shader itself is mostly fetches:
+//   warpLut   rg = curved uv, b = vignette of the curved uv, a = vignette flat
+//   scanLut   one scanline period (2 px) of sin(), tiled
+//   noiseTex  64x64 white noise for the dither, tiled per screen pixel
+
 in vec2 fragTexCoord;
 out vec4 finalColor;
 
 uniform sampler2D texture0;
-uniform float time;
+uniform sampler2D warpLut;
+uniform sampler2D scanLut;
+uniform sampler2D noiseTex;
 
-uniform float curvature;
 uniform float scanlineIntensity;
-uniform float vignette;
 uniform float ditherStrength;
-
 uniform float chromAberration;
-uniform float jitterStrength;
-uniform float jitterSpeed;
 
+uniform vec2 jitterOffset;   // uv units, worked out on the CPU per frame
 uniform vec2 resolution;
 
+// part of texture0 that holds the frame { u0, v0, du, dv }, the pooled
+// render target can be bigger than what was drawn
+uniform vec4 region;
+
+const float LUT_SIZE = 256.0;
+const float NOISE_SIZE = 64.0;
+
+vec4 Sample(vec2 uv) {
+    // wrap inside the region like the old full-size target did
+    return texture(texture0, region.xy + fract(uv) * region.zw);
+}
+
 void main() {
-    vec2 uv = fragTexCoord;
+    vec2 uv = (fragTexCoord - region.xy) / region.zw;
 
+#ifdef FX_JITTER
     // --- Subpixel jitter (screen wobble) ---
-    float jitter = sin(time * jitterSpeed) * jitterStrength;
-    uv.x += jitter / resolution.x;
-    uv.y += cos(time * jitterSpeed * 0.7) * jitterStrength / resolution.y;
+    uv += jitterOffset;
+#endif
+
+#if defined(FX_CURVATURE) || defined(FX_VIGNETTE)
+    // texel centres sit on 0 and 1 exactly
+    vec4 warp = texture(warpLut, uv * ((LUT_SIZE - 1.0) / LUT_SIZE) + 0.5 / LUT_SIZE);
+#endif
 
+#ifdef FX_CURVATURE
     // --- CRT curvature ---
-    uv = uv * 2.0 - 1.0;
-    float r = dot(uv, uv);
-    uv *= 1.0 + curvature * r * 2.0;
-    uv = uv * 0.5 + 0.5;
+    uv = warp.rg;
+#endif
 
+#ifdef FX_CHROMA
     // --- Chromatic aberration (RGB split) ---
     float ca = chromAberration / resolution.x;
 
-    vec4 colR = texture(texture0, uv + vec2( ca, 0.0));
-    vec4 colG = texture(texture0, uv);
-    vec4 colB = texture(texture0, uv - vec2( ca, 0.0));
+    vec4 colR = Sample(uv + vec2( ca, 0.0));
+    vec4 colG = Sample(uv);
+    vec4 colB = Sample(uv - vec2( ca, 0.0));
 
     vec4 color = vec4(colR.r, colG.g, colB.b, 1.0);
+#else
+    vec4 color = vec4(Sample(uv).rgb, 1.0);
+#endif
 
+#ifdef FX_SCANLINES
     // --- Scanlines ---
-    float scanline = sin(uv.y * resolution.y * 3.14159);
+    float scanline = texture(scanLut, vec2(0.5, uv.y * resolution.y * 0.5)).r * 2.0 - 1.0;
     color.rgb -= scanline * scanlineIntensity;
+#endif
 
+#ifdef FX_DITHER
     // --- Pixel-locked dithering ---
-    vec2 pixel = floor(uv * resolution);
-    float dither = fract(sin(dot(pixel, vec2(12.9898, 78.233))) * 43758.5453);
+    float dither = texture(noiseTex, (floor(uv * resolution) + 0.5) / NOISE_SIZE).r;
     color.rgb += (dither - 0.5) * ditherStrength;
+#endif
 
+#ifdef FX_VIGNETTE
     // --- Vignette ---
-    float dist = distance(uv, vec2(0.5));
-    color.rgb *= smoothstep(0.85, vignette, dist);
+#ifdef FX_CURVATURE
+    color.rgb *= warp.b;
+#else
+    color.rgb *= warp.a;
+#endif
+#endif
 
     finalColor = color;
 }
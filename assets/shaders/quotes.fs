@@ -0,0 +1,14 @@
+#version 330
+
+in vec2 fragTexCoord;
+in float fragAlpha;
+out vec4 finalColor;
+
+uniform sampler2D texture0;   // default font atlas
+
+const vec3 QUOTE_COLOR = vec3(200.0, 30.0, 30.0) / 255.0;
+
+void main() {
+    vec4 texel = texture(texture0, fragTexCoord);
+    finalColor = vec4(QUOTE_COLOR * texel.rgb, texel.a * fragAlpha);
+}
@@ -0,0 +1,45 @@
+#version 330
+
+// Menu quotes, see menuquotes.cpp. The mesh never changes, every vertex is a
+// glyph corner relative to its quote's origin and carries the quote's seeds:
+//   vertexNormal   xy = start position (0..1 of the screen), z = rotation (deg)
+//   vertexTangent  xy = drift (px per 1/20 s), z = base alpha, w = flicker seed
+
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+in vec3 vertexNormal;
+in vec4 vertexTangent;
+
+uniform mat4 mvp;
+uniform float time;      // seconds since the menu opened
+uniform vec2 screen;
+
+out vec2 fragTexCoord;
+out float fragAlpha;
+
+// same soft wrap margins the CPU version had
+const vec2 MARGIN = vec2(200.0, 100.0);
+
+void main() {
+    vec2 start = vertexNormal.xy * screen;
+    vec2 drift = vertexTangent.xy * 20.0 * time;
+
+    vec2 lo = -MARGIN;
+    vec2 span = screen + 2.0 * MARGIN;
+    vec2 origin = lo + mod(start + drift - lo, span);
+
+    float rad = radians(vertexNormal.z);
+    float s = sin(rad);
+    float c = cos(rad);
+    vec2 p = vertexPosition.xy;
+    vec2 pos = origin + vec2(p.x * c - p.y * s, p.x * s + p.y * c);
+
+    // two detuned sines read as a slow random flicker
+    float seed = vertexTangent.w;
+    float flicker = 0.08 * sin(time * 1.3 + seed * 6.2831) +
+                    0.04 * sin(time * 3.7 + seed * 17.0);
+    fragAlpha = clamp(vertexTangent.z + flicker, 0.2, 0.9);
+
+    fragTexCoord = vertexTexCoord;
+    gl_Position = mvp * vec4(pos, 0.0, 1.0);
+}
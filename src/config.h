@@ -1,8 +1,16 @@
 #pragma once 
 #include <string>
+#include <cstdint>
 
 constexpr int TARGET_FPS = 60;
 
+// Frame pacing: fixed TARGET_FPS, the monitor's refresh rate (never below
+// TARGET_FPS), or as fast as it goes
+#define PACE_FIXED    0
+#define PACE_DISPLAY  1
+#define PACE_UNCAPPED 2
+#define FRAME_PACING  PACE_DISPLAY
+
 #define TILE_SIZE 16
 #define GRID_W 16
 #define GRID_H 12
@@ -10,12 +18,35 @@ constexpr int TARGET_FPS = 60;
 #define SCREEN_WIDTH 960
 #define SCREEN_HEIGHT 720
 
+// Draw world + UI into a small target and upscale it by a whole number in
+// the CRT pass, so fill rate doesn't grow with the window
+#define PIXEL_PERFECT 1
+#define PIXEL_PERFECT_TILE 32   // smallest on-target tile size, matches the sprites
+
+// Render targets come from a size-bucketed pool, and a window drag only
+// re-lays things out once the size has stopped changing for a bit
+#define RT_POOL_BUCKET 128      // px, target sizes are rounded up to this
+#define RT_POOL_FREE   3        // spare targets kept around
+constexpr float RESIZE_SETTLE = 0.15f;
+
+// Nothing pressed and nothing moving for IDLE_AFTER seconds drops the
+// present rate, saves the fans. Audio keeps running, the loop never blocks
+#define ENABLE_IDLE_THROTTLE 1
+constexpr int   IDLE_FPS   = 30;
+constexpr float IDLE_AFTER = 3.0f;
+
 #define HOTBAR_SLOTS 2
+// drifting lore text behind the hotbar, particles.h keeps this cheap
+constexpr int UI_NOISE_COUNT = 40;
 #define UI_HEIGHT 256
 
 constexpr float DEATH_SCREEN_DURATION = 3.0f;
 
-// Post-processing shizz
+// Timing probes and the F3 frame overlay. The probes only record (and write
+// their summary + chrome trace on exit) when started with --profile
+#define ENABLE_PROFILE    1
+
+// Post-processing shizz, these cap what the runtime quality tiers may use
 #define ENABLE_CRT        1
 #define ENABLE_DITHER     1
 
@@ -30,5 +61,31 @@ constexpr float CHROM_ABERRATION = 1.5f;   // (0.5–2.0 is good)
 constexpr float JITTER_STRENGTH  = 0.6f;   // subpixel wobble (0.2–1.0)
 constexpr float JITTER_SPEED     = 2.4f;  // higher = shakier
 
+// Soundtrack, the qoa is made from the wav by `make music`
+constexpr const char* MUSIC_FILE          = "assets/sounds/main_theme.qoa";
+constexpr const char* MUSIC_FILE_FALLBACK = "assets/sounds/main_theme.wav";
+
+// Procedural sound effects, rendered once and kept as PCM in cache/sfx/
+#define SYNTH_DISK_CACHE  1
+constexpr int SYNTH_SAMPLE_RATE = 22050;
+
+// Effects mixer, voices beyond this steal the lowest priority / oldest one
+constexpr int MIXER_VOICES = 16;
+// frames per stream sub-buffer (raylib keeps two). Lower = less lag, too low
+// underruns, check with --audio-loopback [--audio-buffer N]. 0 = raylib's
+// default, rate / 30
+constexpr int AUDIO_BUFFER_FRAMES = 512;
+
+// rng.h streams, 0 = new seed every run (--seed N overrides)
+constexpr uint64_t RNG_SEED = 0;
+
+// Run the game simulation on its own thread, one frame ahead of rendering
+// (simthread.h). Uses a second core and hides level loads, costs a frame of
+// input latency. --no-pipeline steps it inline instead
+constexpr bool PIPELINED_SIM = true;
+
+// Sprite sheet clips for tiles, player and hotbar
+constexpr const char* ANIM_FILE = "assets/anims.txt";
+
 constexpr const char* START_LEVEL = "levels/tutorial01.txt";
 //constexpr const char* START_LEVEL = "levels/level02.txt";
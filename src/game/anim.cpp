@@ -0,0 +1,176 @@
+#include "anim.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct AnimClip {
+    std::string name;
+    int texture;      // into gTextures
+    int firstRect;    // into gRects, frames in a row
+    int frames;
+    float fps;
+    int current;      // resolved by AnimUpdate
+};
+
+static std::vector<AnimClip> gClips;
+static std::vector<Rectangle> gRects;
+static std::vector<Texture2D> gTextures;
+static std::vector<std::string> gTexturePaths;   // same order as gTextures
+static std::vector<int> gTileClips;              // by Tile, ANIM_NONE if static
+
+// -----------------------------
+// Helpers
+// -----------------------------
+
+static int LoadSheet(const std::string& path) {
+    for (int i = 0; i < (int)gTexturePaths.size(); i++) {
+        if (gTexturePaths[i] == path) return i;
+    }
+
+    Texture2D tex = LoadTexture(path.c_str());
+    SetTextureFilter(tex, TEXTURE_FILTER_POINT);
+
+    gTextures.push_back(tex);
+    gTexturePaths.push_back(path);
+    return (int)gTextures.size() - 1;
+}
+
+static bool ParseClip(std::istringstream& in, int lineNo) {
+    AnimClip clip;
+    std::string path;
+    int columns = 0, frameW = 0, frameH = 0;
+
+    if (!(in >> clip.name >> path >> clip.frames >> columns >> clip.fps >> frameW >> frameH) ||
+        clip.frames < 1 || columns < 1 || frameW < 1 || frameH < 1) {
+        TraceLog(LOG_WARNING, "ANIM: bad CLIP on line %d", lineNo);
+        return false;
+    }
+
+    if (AnimFind(clip.name.c_str()) != ANIM_NONE) {
+        TraceLog(LOG_WARNING, "ANIM: clip '%s' defined twice (line %d)", clip.name.c_str(), lineNo);
+        return false;
+    }
+
+    clip.texture = LoadSheet(path);
+    clip.firstRect = (int)gRects.size();
+    clip.current = 0;
+
+    for (int f = 0; f < clip.frames; f++) {
+        gRects.push_back(Rectangle{
+            (float)((f % columns) * frameW),
+            (float)((f / columns) * frameH),
+            (float)frameW,
+            (float)frameH
+        });
+    }
+
+    gClips.push_back(clip);
+    return true;
+}
+
+static bool ParseTileBinding(std::istringstream& in, int lineNo) {
+    std::string tileName, clipName;
+    Tile tile;
+
+    if (!(in >> tileName >> clipName) || !ParseTile(tileName, tile)) {
+        TraceLog(LOG_WARNING, "ANIM: bad TILE on line %d", lineNo);
+        return false;
+    }
+
+    int clip = AnimFind(clipName.c_str());
+    if (clip == ANIM_NONE) {
+        TraceLog(LOG_WARNING, "ANIM: unknown clip '%s' on line %d", clipName.c_str(), lineNo);
+        return false;
+    }
+
+    if ((int)gTileClips.size() <= tile) gTileClips.resize(tile + 1, ANIM_NONE);
+    gTileClips[tile] = clip;
+    return true;
+}
+
+// -----------------------------
+// Public API
+// -----------------------------
+
+bool AnimInit(const char* path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        TraceLog(LOG_WARNING, "ANIM: can't open %s", path);
+        return false;
+    }
+
+    std::string line;
+    int lineNo = 0;
+    bool ok = true;
+
+    while (std::getline(file, line)) {
+        lineNo++;
+
+        std::istringstream in(line);
+        std::string kind;
+        if (!(in >> kind) || kind[0] == '#') continue;
+
+        if (kind == "CLIP")      ok &= ParseClip(in, lineNo);
+        else if (kind == "TILE") ok &= ParseTileBinding(in, lineNo);
+        else {
+            TraceLog(LOG_WARNING, "ANIM: unknown entry '%s' on line %d", kind.c_str(), lineNo);
+            ok = false;
+        }
+    }
+
+    TraceLog(LOG_INFO, "ANIM: %d clips, %d frames, %d sheets",
+             (int)gClips.size(), (int)gRects.size(), (int)gTextures.size());
+    return ok;
+}
+
+void AnimShutdown() {
+    for (const Texture2D& tex : gTextures)
+        UnloadTexture(tex);
+
+    gClips.clear();
+    gRects.clear();
+    gTextures.clear();
+    gTexturePaths.clear();
+    gTileClips.clear();
+}
+
+void AnimUpdate(double time) {
+    for (AnimClip& clip : gClips)
+        clip.current = (int)(time * clip.fps) % clip.frames;
+}
+
+int AnimFind(const char* name) {
+    for (int i = 0; i < (int)gClips.size(); i++) {
+        if (gClips[i].name == name) return i;
+    }
+    return ANIM_NONE;
+}
+
+int AnimTileClip(Tile tile) {
+    if (tile < 0 || tile >= (int)gTileClips.size()) return ANIM_NONE;
+    return gTileClips[tile];
+}
+
+int AnimCurrentFrame(int clip) {
+    return gClips[clip].current;
+}
+
+int AnimFrameAt(int clip, float time) {
+    const AnimClip& c = gClips[clip];
+    if (c.frames <= 1 || time <= 0.0f) return 0;
+    return (int)(time * c.fps) % c.frames;
+}
+
+Rectangle AnimRect(int clip, int frame) {
+    return gRects[gClips[clip].firstRect + frame];
+}
+
+Texture2D AnimTexture(int clip) {
+    return gTextures[gClips[clip].texture];
+}
+
+void AnimDraw(int clip, int frame, Rectangle dst, Color tint) {
+    const AnimClip& c = gClips[clip];
+    DrawTexturePro(gTextures[c.texture], gRects[c.firstRect + frame], dst, Vector2{0, 0}, 0.0f, tint);
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <raylib.h>
+#include "world.h"
+
+// Sprite sheet clips, loaded from ANIM_FILE. Clips live in one table, their
+// source rects in another, so drawing a frame is two array lookups.
+//
+// Clips that run off the shared clock (tiles) get their frame worked out once
+// per frame in AnimUpdate. Things with their own timer (player, hotbar) ask
+// AnimFrameAt with it.
+
+constexpr int ANIM_NONE = -1;
+
+bool AnimInit(const char* path);
+void AnimShutdown();
+
+// once per rendered frame, before anything draws
+void AnimUpdate(double time);
+
+int AnimFind(const char* name);          // ANIM_NONE if there's no such clip
+int AnimTileClip(Tile tile);             // ANIM_NONE for static tiles
+
+int AnimCurrentFrame(int clip);          // frame at the time AnimUpdate got
+int AnimFrameAt(int clip, float time);   // frame at a clip-local time
+
+Rectangle AnimRect(int clip, int frame);
+Texture2D AnimTexture(int clip);
+
+void AnimDraw(int clip, int frame, Rectangle dst, Color tint = WHITE);
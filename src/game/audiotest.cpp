@@ -0,0 +1,115 @@
+#include "audiotest.h"
+#include "../config.h"
+#include "mixer.h"
+#include "rng.h"
+#include "sound.h"
+#include <raylib.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+constexpr int LOOPBACK_EVENTS = 48;
+constexpr double LOOPBACK_SPACING = 0.3;   // s, longer than any one-shot effect
+constexpr double LOOPBACK_HOLD = 0.15;     // s a movement gate stays open
+constexpr float ONSET_LEVEL = 1.0e-4f;
+
+struct LatencyStats {
+    float avg = 0, p50 = 0, p95 = 0, max = 0;
+};
+
+// -----------------------------
+// Helpers
+// -----------------------------
+
+static LatencyStats Summarise(std::vector<float> ms) {
+    LatencyStats s;
+    if (ms.empty()) return s;
+
+    std::sort(ms.begin(), ms.end());
+
+    double total = 0.0;
+    for (float x : ms) total += x;
+
+    int n = (int)ms.size();
+    s.avg = (float)(total / n);
+    s.p50 = ms[std::min(n - 1, n / 2)];
+    s.p95 = ms[std::min(n - 1, (int)(n * 0.95f))];
+    s.max = ms.back();
+    return s;
+}
+
+// one-shots with a hard onset (the wind equip fades in and would skew it),
+// and the live movement voice, gated and released like a stone step
+static void FireEvent(int i) {
+    switch (i % 3) {
+        case 0: SoundOnPlate(); break;
+        case 1: SoundOnMaskSwitch(MASK_STONE); break;
+        case 2:
+            SoundOnMoveStart(MASK_STONE, 0);
+            std::this_thread::sleep_for(std::chrono::duration<double>(LOOPBACK_HOLD));
+            SoundOnMoveStop(MASK_STONE);
+            break;
+    }
+}
+
+static void PrintRow(const char* name, const LatencyStats& s) {
+    printf("%-18s %8.2f %8.2f %8.2f %8.2f\n", name, s.avg, s.p50, s.p95, s.max);
+}
+
+// -----------------------------
+// Public API
+// -----------------------------
+
+int AudioLoopbackRun(int bufferFrames) {
+    MixerSetBufferFrames(bufferFrames);
+    SoundInit(true);
+
+    const int frames = MixerBufferFrames();
+    const double period = (double)frames / SYNTH_SAMPLE_RATE;
+
+    for (int i = 0; i < LOOPBACK_EVENTS; i++) {
+        // jitter so events land all over the block, not in lockstep with it
+        double wait = LOOPBACK_SPACING + period * RngFloat(RngGet(RNG_AUDIO));
+        std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+        FireEvent(i);
+    }
+    std::this_thread::sleep_for(std::chrono::duration<double>(LOOPBACK_SPACING));
+
+    SoundShutdown();
+
+    const MixerLoopback& rec = MixerLoopbackResult();
+    std::vector<float> pickupMs, sampleMs, gateMs;
+
+    MixerEvent e;
+    while (MixerPollEvent(e)) {
+        if (!e.onset) continue;
+
+        pickupMs.push_back((float)((e.submitTime - e.postTime) * 1000.0));
+
+        // first audible frame from the block it started in
+        uint64_t end = std::min<uint64_t>(e.frame + 2 * frames, rec.samples.size());
+        for (uint64_t f = e.frame; f < end; f++) {
+            if (fabsf(rec.samples[f]) < ONSET_LEVEL) continue;
+
+            // a device plays a block once the other sub-buffer has drained
+            size_t block = f / frames;
+            double heard = rec.blockTimes[block] + period + (double)(f % frames) / SYNTH_SAMPLE_RATE;
+            float ms = (float)((heard - e.postTime) * 1000.0);
+            if (e.sample >= 0) sampleMs.push_back(ms);
+            else               gateMs.push_back(ms);
+            break;
+        }
+    }
+
+    printf("audio loopback: %d frame buffer (%.1f ms), %d events, %d blocks, %d late\n",
+           frames, period * 1000.0, (int)pickupMs.size(), (int)rec.blockTimes.size(), rec.late);
+    printf("%-18s %8s %8s %8s %8s\n", "ms", "avg", "p50", "p95", "max");
+    PrintRow("event -> mixer", Summarise(pickupMs));
+    PrintRow("event -> sample", Summarise(sampleMs));
+    PrintRow("gate -> sample", Summarise(gateMs));
+
+    return rec.late > 0 ? 1 : 0;
+}
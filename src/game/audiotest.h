@@ -0,0 +1,10 @@
+#pragma once
+
+// --audio-loopback [--audio-buffer N]: no window, no audio device. The mixer
+// runs against a null device that paces it in real time and records the
+// output, while a string of gameplay sound events goes through the normal
+// SoundOn* path. Prints event -> mixer pickup and event -> first sample
+// latency plus the blocks a real device would have underrun on.
+//
+// Returns the process exit code, non-zero if anything underran.
+int AudioLoopbackRun(int bufferFrames);
@@ -0,0 +1,199 @@
+#include "catalogue.h"
+#include "level.h"
+#include "save.h"
+#include "profile.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+static const char* CATALOGUE_FILE    = "levels.idx";
+static const char* CATALOGUE_DIR     = "levels";
+static const char* CATALOGUE_VERSION = "FORMLESS_CATALOGUE 2";
+
+static std::mutex gCatalogueMutex;
+static std::vector<CatalogueEntry> gEntries;
+static std::atomic<unsigned int> gGeneration{0};
+
+static std::thread gScanThread;
+static std::atomic<bool> gScanning{false};
+
+// -----------------------------
+// Index file
+// -----------------------------
+
+static std::vector<CatalogueEntry> ReadIndex() {
+    std::vector<CatalogueEntry> out;
+
+    std::ifstream in(CATALOGUE_FILE);
+    std::string line;
+
+    if (!std::getline(in, line) || line != CATALOGUE_VERSION)
+        return out;
+
+    while (std::getline(in, line)) {
+        std::stringstream ss(line);
+        CatalogueEntry e{};
+        int mask = 0;
+        int invalid = 0;
+
+        // path \t mtime \t invalid \t w \t h \t mask \t uses \t next
+        if (!std::getline(ss, e.path, '\t')) continue;
+        if (!(ss >> e.mtime >> invalid >> e.width >> e.height >> mask >> e.maskUses)) continue;
+        ss.ignore(1);
+        std::getline(ss, e.nextLevelPath);
+
+        e.invalid = invalid != 0;
+        e.startMask = (MaskType)mask;
+        e.name = std::filesystem::path(e.path).stem().string();
+        out.push_back(e);
+    }
+    return out;
+}
+
+static void WriteIndex(const std::vector<CatalogueEntry>& entries) {
+    std::string tmp = std::string(CATALOGUE_FILE) + ".tmp";
+
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        if (!out.is_open()) return;
+
+        out << CATALOGUE_VERSION << "\n";
+        for (const auto& e : entries) {
+            out << e.path << '\t'
+                << e.mtime << '\t'
+                << (int)e.invalid << '\t'
+                << e.width << '\t'
+                << e.height << '\t'
+                << (int)e.startMask << '\t'
+                << e.maskUses << '\t'
+                << e.nextLevelPath << "\n";
+        }
+        if (!out.good()) return;
+    }
+
+    // readers never see a half written index
+    std::error_code ec;
+    std::filesystem::rename(tmp, CATALOGUE_FILE, ec);
+}
+
+// -----------------------------
+// Scanning
+// -----------------------------
+
+// broken files stay in with invalid set, so they still show up and their
+// mtime keeps them from being reparsed every scan
+static void ParseEntry(const std::filesystem::path& file, CatalogueEntry& e) {
+    e.name = file.stem().string();
+
+    Level level{};
+    // Parse, not LoadFromFile, that one's probe is for the game's own loads
+    if (!level.Parse(e.path)) {
+        e.invalid = true;
+        return;
+    }
+
+    e.width         = level.world.width;
+    e.height        = level.world.height;
+    e.startMask     = level.startMask;
+    e.maskUses      = level.maskUses;
+    e.nextLevelPath = NormalizePath(level.nextLevelPath);
+}
+
+static void ScanLevels() {
+    PROFILE_SCOPE("CatalogueScan");
+
+    std::unordered_map<std::string, CatalogueEntry> known;
+    {
+        std::lock_guard<std::mutex> lock(gCatalogueMutex);
+        for (const auto& e : gEntries) known[e.path] = e;
+    }
+
+    std::vector<CatalogueEntry> fresh;
+    bool changed = false;
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(CATALOGUE_DIR, ec)) {
+        if (!entry.is_regular_file()) continue;
+        if (entry.path().extension() != ".txt") continue;
+
+        CatalogueEntry e{};
+        e.path  = NormalizePath(entry.path().string());
+        e.mtime = (int64_t)entry.last_write_time(ec).time_since_epoch().count();
+
+        auto it = known.find(e.path);
+        if (it != known.end() && it->second.mtime == e.mtime) {
+            fresh.push_back(it->second);
+            known.erase(it);
+            continue;
+        }
+
+        // new or touched since the last scan
+        changed = true;
+        if (it != known.end()) known.erase(it);
+        ParseEntry(entry.path(), e);
+        fresh.push_back(e);
+    }
+
+    // anything left over was deleted
+    if (!known.empty()) changed = true;
+
+    if (!changed) return;
+
+    std::sort(fresh.begin(), fresh.end(),
+        [](const CatalogueEntry& a, const CatalogueEntry& b) {
+            return a.path < b.path;
+        });
+
+    WriteIndex(fresh);
+
+    {
+        std::lock_guard<std::mutex> lock(gCatalogueMutex);
+        gEntries = std::move(fresh);
+    }
+    gGeneration++;
+}
+
+// -----------------------------
+// Public API
+// -----------------------------
+
+void CatalogueInit() {
+    {
+        std::lock_guard<std::mutex> lock(gCatalogueMutex);
+        gEntries = ReadIndex();
+    }
+    gGeneration++;
+
+    CatalogueRefresh();
+}
+
+void CatalogueRefresh() {
+    if (gScanning.exchange(true)) return;
+
+    if (gScanThread.joinable())
+        gScanThread.join();
+
+    gScanThread = std::thread([] {
+        ScanLevels();
+        gScanning = false;
+    });
+}
+
+void CatalogueShutdown() {
+    if (gScanThread.joinable())
+        gScanThread.join();
+}
+
+std::vector<CatalogueEntry> CatalogueSnapshot() {
+    std::lock_guard<std::mutex> lock(gCatalogueMutex);
+    return gEntries;
+}
+
+unsigned int CatalogueGeneration() {
+    return gGeneration.load();
+}
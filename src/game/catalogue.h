@@ -0,0 +1,34 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "mask.h"
+
+// Cached index of everything under levels/. The index lives on disk next to
+// save.txt and is refreshed from file mtimes on a background thread, so the
+// menu never has to touch the filesystem itself.
+
+struct CatalogueEntry {
+    std::string path;          // normalized, e.g. "levels/level01.txt"
+    std::string name;          // file stem
+    int64_t mtime;
+    bool invalid;              // didn't parse, listed as broken, fields below unset
+
+    int width;
+    int height;
+    MaskType startMask;
+    int maskUses;
+    std::string nextLevelPath;
+};
+
+// lifecycle
+void CatalogueInit();
+void CatalogueShutdown();
+
+// kicks off a rescan unless one is already running
+void CatalogueRefresh();
+
+// sorted by path
+std::vector<CatalogueEntry> CatalogueSnapshot();
+// bumps every time the entries change, cheap to poll per frame
+unsigned int CatalogueGeneration();
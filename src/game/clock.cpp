@@ -0,0 +1,18 @@
+#include "clock.h"
+#include <raylib.h>
+
+static bool gFixed = false;
+static double gFixedTime = 0.0;
+
+double ClockTime() {
+    return gFixed ? gFixedTime : GetTime();
+}
+
+void ClockSetFixed(double t) {
+    gFixed = true;
+    gFixedTime = t;
+}
+
+void ClockClearFixed() {
+    gFixed = false;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+// Time source for everything that animates off absolute time (tile anims,
+// CRT jitter). Normally GetTime(), --headless pins it per scripted frame so
+// two runs render the same pixels.
+
+double ClockTime();
+void ClockSetFixed(double t);
+void ClockClearFixed();
@@ -0,0 +1,336 @@
+#include "frameprof.h"
+
+#if ENABLE_PROFILE
+
+#include "pacer.h"
+#include <raylib.h>
+#include <rlgl.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+// raylib keeps its GL loader to itself, on linux libGL exports the query
+// entry points directly. Elsewhere the GPU column just stays empty.
+#if defined(__linux__)
+#define GL_GLEXT_PROTOTYPES
+#include <GL/gl.h>
+#include <GL/glext.h>
+#define FRAMEPROF_GPU 1
+#else
+#define FRAMEPROF_GPU 0
+#endif
+
+constexpr int FRAME_HISTORY = 240;
+constexpr int GPU_LAG       = 4;     // queries in flight per scope
+
+using FrameClock = std::chrono::steady_clock;
+
+struct GpuQuery {
+    unsigned int id = 0;
+    int frame = -1;     // frame it measures, -1 when free
+};
+
+struct Track {
+    const char* name;
+    bool gpu;
+    double cpuNow = 0.0;          // ms so far this frame
+    bool queried = false;         // one GPU query per scope per frame
+    float cpu[FRAME_HISTORY];
+    float gpuMs[FRAME_HISTORY];   // -1 = no result
+    GpuQuery queries[GPU_LAG];
+};
+
+struct OpenScope {
+    int track;
+    FrameClock::time_point start;
+    bool query;
+};
+
+static std::vector<Track> gTracks;
+static std::vector<OpenScope> gStack;
+
+static float gFrameMs[FRAME_HISTORY];
+static int gFrame = 0;       // frame currently being recorded
+static int gRecorded = 0;    // closed frames, capped by the history
+
+static bool gVisible = false;
+static bool gQueryActive = false;   // GL timer queries don't nest
+
+// -----------------------------
+// Helpers
+// -----------------------------
+
+static int FindTrack(const char* name, bool gpu) {
+    for (int i = 0; i < (int)gTracks.size(); i++) {
+        if (gTracks[i].name == name || strcmp(gTracks[i].name, name) == 0)
+            return i;
+    }
+
+    Track t;
+    t.name = name;
+    t.gpu = gpu;
+    std::fill(std::begin(t.cpu), std::end(t.cpu), 0.0f);
+    std::fill(std::begin(t.gpuMs), std::end(t.gpuMs), -1.0f);
+    gTracks.push_back(t);
+    return (int)gTracks.size() - 1;
+}
+
+static int HistoryCount() {
+    return std::min(gRecorded, FRAME_HISTORY);
+}
+
+// ring slot of the n-th oldest closed frame
+static int HistorySlot(int n) {
+    return (gFrame - HistoryCount() + n) % FRAME_HISTORY;
+}
+
+struct Summary {
+    int count = 0;
+    float avg = 0, p50 = 0, p95 = 0, p99 = 0, max = 0;
+};
+
+static Summary Summarise(const float* ring) {
+    static std::vector<float> v;
+    v.clear();
+
+    for (int i = 0; i < HistoryCount(); i++) {
+        float x = ring[HistorySlot(i)];
+        if (x >= 0.0f) v.push_back(x);
+    }
+
+    Summary s;
+    s.count = (int)v.size();
+    if (v.empty()) return s;
+
+    std::sort(v.begin(), v.end());
+
+    double total = 0.0;
+    for (float x : v) total += x;
+
+    auto pct = [&](float p) { return v[std::min(s.count - 1, (int)(p * s.count))]; };
+
+    s.avg = (float)(total / s.count);
+    s.p50 = pct(0.50f);
+    s.p95 = pct(0.95f);
+    s.p99 = pct(0.99f);
+    s.max = v.back();
+    return s;
+}
+
+static void CollectGpu() {
+#if FRAMEPROF_GPU
+    for (auto& t : gTracks) {
+        for (auto& q : t.queries) {
+            if (q.frame < 0) continue;
+
+            GLint ready = 0;
+            glGetQueryObjectiv(q.id, GL_QUERY_RESULT_AVAILABLE, &ready);
+            if (!ready) continue;
+
+            GLuint64 ns = 0;
+            glGetQueryObjectui64v(q.id, GL_QUERY_RESULT, &ns);
+
+            if (gFrame - q.frame < FRAME_HISTORY)
+                t.gpuMs[q.frame % FRAME_HISTORY] = ns / 1.0e6f;
+            q.frame = -1;
+        }
+    }
+#endif
+}
+
+static void WriteRing(FILE* f, const float* ring) {
+    fprintf(f, "[");
+    for (int i = 0; i < HistoryCount(); i++)
+        fprintf(f, "%s%.3f", i ? "," : "", ring[HistorySlot(i)]);
+    fprintf(f, "]");
+}
+
+static void WriteCapture() {
+    char path[64];
+    snprintf(path, sizeof(path), "profile_capture_%lld.json", (long long)time(nullptr));
+
+    FILE* f = fopen(path, "w");
+    if (!f) return;
+
+    // oldest frame first, gpu -1 where no query result came back
+    fprintf(f, "{\"frames\":%d,\"target_fps\":%d,\"pacing\":\"%s\",\"latency_ms\":%.2f,\"frame_ms\":",
+            HistoryCount(), PacerRate(), PacerModeName(), PacerLatencyMs());
+    WriteRing(f, gFrameMs);
+    fprintf(f, ",\n\"scopes\":[\n");
+    for (size_t i = 0; i < gTracks.size(); i++) {
+        const Track& t = gTracks[i];
+        fprintf(f, "{\"name\":\"%s\",\"cpu_ms\":", t.name);
+        WriteRing(f, t.cpu);
+        if (t.gpu) {
+            fprintf(f, ",\"gpu_ms\":");
+            WriteRing(f, t.gpuMs);
+        }
+        fprintf(f, "}%s\n", i + 1 < gTracks.size() ? "," : "");
+    }
+    fprintf(f, "]}\n");
+    fclose(f);
+
+    TraceLog(LOG_INFO, "PROFILE: capture written to %s", path);
+}
+
+// -----------------------------
+// Public API
+// -----------------------------
+
+void FrameProfBegin(float dt) {
+    if (IsKeyPressed(KEY_F3)) gVisible = !gVisible;
+
+    // close the previous frame
+    int slot = gFrame % FRAME_HISTORY;
+    gFrameMs[slot] = dt * 1000.0f;
+    for (auto& t : gTracks)
+        t.cpu[slot] = (float)t.cpuNow;
+    gRecorded++;
+    gFrame++;
+
+    // and open this one
+    slot = gFrame % FRAME_HISTORY;
+    for (auto& t : gTracks) {
+        t.cpuNow = 0.0;
+        t.queried = false;
+        t.gpuMs[slot] = -1.0f;
+    }
+
+    CollectGpu();
+
+    if (IsKeyPressed(KEY_F4)) WriteCapture();
+}
+
+void FrameProfScopeBegin(const char* name, bool gpu) {
+    int index = FindTrack(name, gpu);
+    bool query = false;
+
+#if FRAMEPROF_GPU
+    // only while the overlay is up, the extra batch flushes cost something
+    Track& t = gTracks[index];
+    if (gpu && gVisible && !gQueryActive && !t.queried) {
+        for (auto& q : t.queries) {
+            if (q.frame >= 0) continue;
+            if (!q.id) glGenQueries(1, &q.id);
+
+            // whatever is still batched belongs to the previous scope
+            rlDrawRenderBatchActive();
+            glBeginQuery(GL_TIME_ELAPSED, q.id);
+
+            q.frame = gFrame;
+            t.queried = true;
+            gQueryActive = query = true;
+            break;
+        }
+    }
+#endif
+
+    gStack.push_back({ index, FrameClock::now(), query });
+}
+
+void FrameProfScopeEnd() {
+    if (gStack.empty()) return;
+
+    OpenScope s = gStack.back();
+    gStack.pop_back();
+
+#if FRAMEPROF_GPU
+    if (s.query) {
+        rlDrawRenderBatchActive();
+        glEndQuery(GL_TIME_ELAPSED);
+        gQueryActive = false;
+    }
+#endif
+
+    gTracks[s.track].cpuNow += std::chrono::duration<double, std::milli>(
+        FrameClock::now() - s.start).count();
+}
+
+void FrameProfDrawOverlay() {
+    if (!gVisible) return;
+
+    const int font = 10;
+    const int line = 13;
+    const int x = 8;
+    int y = 8;
+
+    int panelW = 360;
+    int panelH = 4 * line + (int)gTracks.size() * line + 80 + 16;
+    DrawRectangle(x - 4, y - 4, panelW, panelH, Fade(BLACK, 0.75f));
+
+    Summary frame = Summarise(gFrameMs);
+    DrawText(TextFormat("frame ms  avg %.2f  p50 %.2f  p95 %.2f  p99 %.2f  max %.2f",
+                        frame.avg, frame.p50, frame.p95, frame.p99, frame.max),
+             x, y, font, RAYWHITE);
+    y += line;
+    DrawText(TextFormat("pacing %s %d fps   est. input->photon %.1f ms",
+                        PacerModeName(), PacerRate(), PacerLatencyMs()),
+             x, y, font, RAYWHITE);
+    y += line;
+    DrawText(TextFormat("last %d frames   F4 dumps a capture", frame.count),
+             x, y, font, GRAY);
+    y += line + 4;
+
+    DrawText("scope", x, y, font, GRAY);
+    DrawText("cpu avg", x + 150, y, font, GRAY);
+    DrawText("cpu p95", x + 200, y, font, GRAY);
+    DrawText("gpu avg", x + 250, y, font, GRAY);
+    DrawText("gpu p95", x + 300, y, font, GRAY);
+    y += line;
+
+    for (const auto& t : gTracks) {
+        Summary cpu = Summarise(t.cpu);
+        DrawText(t.name, x, y, font, RAYWHITE);
+        DrawText(TextFormat("%.3f", cpu.avg), x + 150, y, font, RAYWHITE);
+        DrawText(TextFormat("%.3f", cpu.p95), x + 200, y, font, RAYWHITE);
+
+        if (t.gpu) {
+            Summary gpu = Summarise(t.gpuMs);
+            if (gpu.count > 0) {
+                DrawText(TextFormat("%.3f", gpu.avg), x + 250, y, font, SKYBLUE);
+                DrawText(TextFormat("%.3f", gpu.p95), x + 300, y, font, SKYBLUE);
+            } else {
+                DrawText("-", x + 250, y, font, GRAY);
+            }
+        }
+        y += line;
+    }
+
+    // rolling frame time graph, the line is the frame budget
+    y += 4;
+    const int graphH = 80;
+    const int barW = std::max(1, (panelW - 8) / FRAME_HISTORY);
+    const float budgetMs = PacerBudget() * 1000.0f;
+    const float graphMaxMs = budgetMs * 2.0f;
+
+    for (int i = 0; i < HistoryCount(); i++) {
+        float ms = gFrameMs[HistorySlot(i)];
+        int h = (int)(std::min(ms, graphMaxMs) / graphMaxMs * graphH);
+
+        Color c = ms <= budgetMs * 1.05f ? GREEN
+                : ms <= budgetMs * 1.5f  ? YELLOW
+                : RED;
+        DrawRectangle(x + i * barW, y + graphH - h, barW, h, c);
+    }
+
+    int budgetY = y + graphH - (int)(budgetMs / graphMaxMs * graphH);
+    DrawLine(x, budgetY, x + FRAME_HISTORY * barW, budgetY, Fade(RAYWHITE, 0.6f));
+}
+
+void FrameProfShutdown() {
+#if FRAMEPROF_GPU
+    for (auto& t : gTracks) {
+        for (auto& q : t.queries) {
+            if (q.id) glDeleteQueries(1, &q.id);
+            q = GpuQuery{};
+        }
+    }
+#endif
+    gTracks.clear();
+    gStack.clear();
+}
+
+#endif
@@ -0,0 +1,42 @@
+#pragma once
+#include "../config.h"
+
+// Per-frame profiler with an in-game overlay (F3). CPU scopes are summed per
+// frame and kept for the last FRAME_HISTORY frames, GPU scopes also wrap a
+// GL timer query (read back a few frames late). F4 dumps the history to
+// profile_capture_<time>.json. Compiled out with ENABLE_PROFILE.
+
+#if ENABLE_PROFILE
+
+// top of the main loop, closes the previous frame (dt is its length)
+void FrameProfBegin(float dt);
+void FrameProfShutdown();
+
+void FrameProfScopeBegin(const char* name, bool gpu);  // name must be a literal
+void FrameProfScopeEnd();
+
+// window space, call after the CRT pass so it stays readable
+void FrameProfDrawOverlay();
+
+struct FrameProfScope {
+    FrameProfScope(const char* name, bool gpu) { FrameProfScopeBegin(name, gpu); }
+    ~FrameProfScope() { FrameProfScopeEnd(); }
+};
+
+#define FRAMEPROF_CONCAT_(a, b) a##b
+#define FRAMEPROF_CONCAT(a, b) FRAMEPROF_CONCAT_(a, b)
+#define PROFILE_FRAME_SCOPE(name) FrameProfScope FRAMEPROF_CONCAT(frameScope_, __LINE__)(name, false)
+#define PROFILE_GPU_SCOPE(name)   FrameProfScope FRAMEPROF_CONCAT(frameScope_, __LINE__)(name, true)
+
+#else
+
+inline void FrameProfBegin(float) {}
+inline void FrameProfShutdown() {}
+inline void FrameProfScopeBegin(const char*, bool) {}
+inline void FrameProfScopeEnd() {}
+inline void FrameProfDrawOverlay() {}
+
+#define PROFILE_FRAME_SCOPE(name) ((void)0)
+#define PROFILE_GPU_SCOPE(name) ((void)0)
+
+#endif
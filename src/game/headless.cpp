@@ -0,0 +1,208 @@
+#include "headless.h"
+#include <raylib.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+static const char* LEVELS_DIR = "levels";
+
+// -----------------------------
+// Helpers
+// -----------------------------
+
+static void PrintUsage() {
+    printf("usage: formless --headless [--frames N] [--dump-every N] [--size WxH]\n"
+           "                [--moves UDLR...] [--out DIR] [level.txt ...]\n"
+           "       formless --audio-loopback [--audio-buffer N]\n"
+           "       any of the above [--seed N] [--profile]\n"
+           "       formless [--no-pipeline]\n");
+}
+
+struct FrameStats {
+    float avg = 0, p50 = 0, p95 = 0, max = 0;
+};
+
+static FrameStats Summarise(std::vector<float> ms) {
+    FrameStats s;
+    if (ms.empty()) return s;
+
+    std::sort(ms.begin(), ms.end());
+
+    double total = 0.0;
+    for (float x : ms) total += x;
+
+    int n = (int)ms.size();
+    s.avg = (float)(total / n);
+    s.p50 = ms[std::min(n - 1, n / 2)];
+    s.p95 = ms[std::min(n - 1, (int)(n * 0.95f))];
+    s.max = ms.back();
+    return s;
+}
+
+// -----------------------------
+// Public API
+// -----------------------------
+
+bool HeadlessParseArgs(int argc, char** argv, HeadlessOptions& opt) {
+    // a normal launch shrugs off whatever a launcher or desktop file passes,
+    // only the tool modes are picky about their arguments
+    bool strict = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--headless") == 0 || strcmp(argv[i], "--audio-loopback") == 0)
+            strict = true;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (strcmp(a, "--headless") == 0) {
+            opt.enabled = true;
+        }
+        else if (strcmp(a, "--frames") == 0 && hasValue) {
+            opt.frames = std::max(1, atoi(argv[++i]));
+        }
+        else if (strcmp(a, "--dump-every") == 0 && hasValue) {
+            opt.dumpEvery = std::max(0, atoi(argv[++i]));
+        }
+        else if (strcmp(a, "--size") == 0 && hasValue) {
+            int w = 0, h = 0;
+            if (sscanf(argv[++i], "%dx%d", &w, &h) != 2 || w <= 0 || h <= 0) {
+                if (!strict) continue;
+                PrintUsage();
+                return false;
+            }
+            opt.width = w;
+            opt.height = h;
+        }
+        else if (strcmp(a, "--moves") == 0 && hasValue) {
+            opt.moves = argv[++i];
+        }
+        else if (strcmp(a, "--profile") == 0) {
+            opt.profile = true;
+        }
+        else if (strcmp(a, "--no-pipeline") == 0) {
+            opt.pipelined = false;
+        }
+        else if (strcmp(a, "--seed") == 0 && hasValue) {
+            opt.seed = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(a, "--audio-loopback") == 0) {
+            opt.audioLoopback = true;
+        }
+        else if (strcmp(a, "--audio-buffer") == 0 && hasValue) {
+            opt.audioBuffer = std::max(0, atoi(argv[++i]));
+        }
+        else if (strcmp(a, "--out") == 0 && hasValue) {
+            opt.outDir = fs::absolute(argv[++i]).string();
+        }
+        else if (!strict) {
+            continue;
+        }
+        else if (a[0] != '-') {
+            // main changes into the executable's directory, pin these first
+            opt.levels.push_back(fs::absolute(a).string());
+        }
+        else {
+            PrintUsage();
+            return false;
+        }
+    }
+
+    if (opt.enabled && !fs::path(opt.outDir).is_absolute())
+        opt.outDir = fs::absolute(opt.outDir).string();
+
+    return true;
+}
+
+void HeadlessResolveLevels(HeadlessOptions& opt) {
+    if (!opt.levels.empty()) return;
+
+    std::error_code ec;
+    for (const auto& entry : fs::recursive_directory_iterator(LEVELS_DIR, ec)) {
+        if (!entry.is_regular_file()) continue;
+        if (entry.path().extension() != ".txt") continue;
+        opt.levels.push_back(entry.path().generic_string());
+    }
+
+    std::sort(opt.levels.begin(), opt.levels.end());
+}
+
+bool HeadlessExport(const PooledTarget& t, const std::string& path) {
+    Image img = LoadImageFromTexture(t.rt.texture);
+
+    // GL rows are bottom up, the drawn region sits at the top of the texture
+    ImageCrop(&img, Rectangle{
+        0,
+        (float)(t.rt.texture.height - t.height),
+        (float)t.width,
+        (float)t.height
+    });
+    ImageFlipVertical(&img);
+
+    std::error_code ec;
+    fs::create_directories(fs::path(path).parent_path(), ec);
+
+    bool ok = ExportImage(img, path.c_str());
+    UnloadImage(img);
+    return ok;
+}
+
+std::string HeadlessDumpPath(const HeadlessOptions& opt, const std::string& level, int frame) {
+    char name[32];
+    snprintf(name, sizeof(name), "_f%04d.png", frame);
+    return (fs::path(opt.outDir) / (fs::path(level).stem().string() + name)).string();
+}
+
+int HeadlessReport(const HeadlessOptions& opt, const std::vector<HeadlessResult>& results) {
+    std::error_code ec;
+    fs::create_directories(opt.outDir, ec);
+
+    std::string reportPath = (fs::path(opt.outDir) / "report.json").string();
+    FILE* f = fopen(reportPath.c_str(), "w");
+
+    printf("%-32s %7s %9s %8s %8s %8s\n", "level", "frames", "fps", "avg ms", "p95 ms", "max ms");
+
+    if (f) fprintf(f, "{\"width\":%d,\"height\":%d,\"frames\":%d,\"levels\":[\n",
+                   opt.width, opt.height, opt.frames);
+
+    int failed = 0;
+    for (size_t i = 0; i < results.size(); i++) {
+        const HeadlessResult& r = results[i];
+        std::string name = fs::path(r.path).filename().string();
+
+        if (!r.loaded) {
+            failed++;
+            printf("%-32s failed to load\n", name.c_str());
+            if (f) fprintf(f, "{\"path\":\"%s\",\"loaded\":false}%s\n",
+                           r.path.c_str(), i + 1 < results.size() ? "," : "");
+            continue;
+        }
+
+        FrameStats s = Summarise(r.frameMs);
+        double fps = r.seconds > 0.0 ? r.frames / r.seconds : 0.0;
+
+        printf("%-32s %7d %9.1f %8.3f %8.3f %8.3f\n",
+               name.c_str(), r.frames, fps, s.avg, s.p95, s.max);
+
+        if (f) {
+            fprintf(f, "{\"path\":\"%s\",\"loaded\":true,\"frames\":%d,\"fps\":%.2f,"
+                       "\"avg_ms\":%.3f,\"p50_ms\":%.3f,\"p95_ms\":%.3f,\"max_ms\":%.3f,\"dumps\":[",
+                    r.path.c_str(), r.frames, fps, s.avg, s.p50, s.p95, s.max);
+            for (size_t d = 0; d < r.dumps.size(); d++)
+                fprintf(f, "%s\"%s\"", d ? "," : "", r.dumps[d].c_str());
+            fprintf(f, "]}%s\n", i + 1 < results.size() ? "," : "");
+        }
+    }
+
+    if (f) {
+        fprintf(f, "]}\n");
+        fclose(f);
+    }
+
+    return failed ? 1 : 0;
+}
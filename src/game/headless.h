@@ -0,0 +1,67 @@
+#pragma once
+#include "../config.h"
+#include "rtpool.h"
+#include <string>
+#include <vector>
+
+// --headless: hidden window, scripted frames per level, PNG dumps for golden
+// image diffs and a frame time report. No audio, no save, no catalogue.
+//
+//   formless --headless [--frames N] [--dump-every N] [--size WxH]
+//            [--moves UDLR...] [--out DIR] [level.txt ...]
+//
+// Any run takes --seed N to pin the random streams and --profile to write
+// the timing probes out on exit (profile.h). The game takes --no-pipeline
+// to step the simulation inline (simthread.h).
+//
+// The audio flags are parsed here as well, see audiotest.h:
+//   formless --audio-loopback [--audio-buffer N]
+//
+// Without levels every .txt under levels/ is run. On a GPU-less box:
+//   LIBGL_ALWAYS_SOFTWARE=1 xvfb-run -s "-screen 0 1280x1024x24" ./formless --headless
+
+struct HeadlessOptions {
+    bool enabled = false;
+    int frames = 120;
+    int dumpEvery = 0;          // 0 = only the last frame
+    int width = SCREEN_WIDTH;
+    int height = SCREEN_HEIGHT + UI_HEIGHT;
+    std::string moves;          // one step per frame the player is free, U/D/L/R
+    std::string outDir = "headless_out";
+    std::vector<std::string> levels;
+
+    uint64_t seed = RNG_SEED;   // --seed N, see rng.h
+
+    bool profile = false;       // --profile, record the timing probes
+
+    bool pipelined = PIPELINED_SIM;   // --no-pipeline, game only
+
+    bool audioLoopback = false;
+    int audioBuffer = AUDIO_BUFFER_FRAMES;   // frames, also used by the game
+};
+
+struct HeadlessResult {
+    std::string path;
+    bool loaded = false;
+    int frames = 0;
+    double seconds = 0.0;
+    std::vector<float> frameMs;
+    std::vector<std::string> dumps;
+};
+
+// false (after printing usage) on bad arguments. Unknown flags and bare
+// arguments are only errors / level paths with --headless or --audio-loopback,
+// a normal launch ignores them
+bool HeadlessParseArgs(int argc, char** argv, HeadlessOptions& opt);
+
+// fills in opt.levels from levels/ if none were given
+void HeadlessResolveLevels(HeadlessOptions& opt);
+
+// read back the drawn region of a pooled target and write it as PNG
+bool HeadlessExport(const PooledTarget& t, const std::string& path);
+
+// "<outDir>/<level name>_f<frame>.png"
+std::string HeadlessDumpPath(const HeadlessOptions& opt, const std::string& level, int frame);
+
+// prints a table and writes <outDir>/report.json, returns the process exit code
+int HeadlessReport(const HeadlessOptions& opt, const std::vector<HeadlessResult>& results);
@@ -1,4 +1,5 @@
 #include "level.h"
+#include "profile.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -10,6 +11,16 @@ static MaskType ParseMask(const std::string& s) {
 }
 
 bool Level::LoadFromFile(const std::string& path) {
+    PROFILE_SCOPE("Level::LoadFromFile");
+
+    Level next{};
+    if (!next.Parse(path)) return false;
+
+    *this = std::move(next);
+    return true;
+}
+
+bool Level::Parse(const std::string& path) {
     std::ifstream file(path);
     if (!file.is_open()) {
         std::cerr << "Failed to open level: " << path << "\n";
@@ -41,16 +52,8 @@ bool Level::LoadFromFile(const std::string& path) {
             std::string tileName;
             ss >> c >> tileName;
 
-            if (tileName == "TILE_EMPTY")              legend[c] = TILE_EMPTY;
-            if (tileName == "TILE_WALL")               legend[c] = TILE_WALL;
-            if (tileName == "TILE_FLAME")              legend[c] = TILE_FLAME;
-            if (tileName == "TILE_PIT")                legend[c] = TILE_PIT;
-            if (tileName == "TILE_GOAL")               legend[c] = TILE_GOAL;
-            if (tileName == "TILE_GLASS")              legend[c] = TILE_GLASS;
-            if (tileName == "TILE_PRESSUREPLATE")      legend[c] = TILE_PRESSUREPLATE;
-            if (tileName == "TILE_PRESSUREPLATE_USED") legend[c] = TILE_PRESSUREPLATE_USED;
-            if (tileName == "TILE_DOOR_CLOSED")        legend[c] = TILE_DOOR_CLOSED;
-            if (tileName == "TILE_DOOR_OPEN")          legend[c] = TILE_DOOR_OPEN;
+            Tile tile;
+            if (ParseTile(tileName, tile)) legend[c] = tile;
         }
         else if (section == WORLD) {
             worldLines.push_back(line);
@@ -113,6 +116,13 @@ bool Level::LoadFromFile(const std::string& path) {
         }
     }
 
+    // World::Get doesn't bounds check, a bad spawn would read garbage
+    if (!world.InBounds(spawnX, spawnY)) {
+        std::cerr << "Level error: SPAWN " << spawnX << " " << spawnY
+                  << " is outside the world\n";
+        return false;
+    }
+
     world.tiles.resize(world.width * world.height);
 
     for (int y = 0; y < world.height; y++) {
@@ -20,7 +20,9 @@ struct Level {
     MaskType startMask;
     int maskUses;
 
+    // leaves the level untouched if the file is broken
     bool LoadFromFile(const std::string& path);
+    bool Parse(const std::string& path);
 
     std::vector<LevelText> texts;  // telltale aahh shi
 
@@ -6,6 +6,15 @@ enum MaskType {
     MASK_WIND
 };
 
+// lowercase, used to build clip names in ANIM_FILE
+inline const char* MaskName(MaskType mask) {
+    switch (mask) {
+        case MASK_STONE: return "stone";
+        case MASK_WIND:  return "wind";
+        default:         return "none";
+    }
+}
+
 inline float MaskMoveDuration(MaskType mask) {
     switch (mask) {
         case MASK_STONE: return 0.4f; 
@@ -0,0 +1,202 @@
+#include "menuquotes.h"
+#include "clock.h"
+#include "profile.h"
+#include "rng.h"
+#include <raylib.h>
+#include <rlgl.h>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+static const char* QUOTES_VS_PATH = "assets/shaders/quotes.vs";
+static const char* QUOTES_FS_PATH = "assets/shaders/quotes.fs";
+
+constexpr int QUOTE_COUNT     = 67;
+constexpr float QUOTE_SIZE    = 20.0f;
+constexpr float QUOTE_SPACING = 1.0f;
+constexpr int MAX_QUOTE_VERTS = 65532;   // 16 bit indices
+
+static Mesh gMesh{};
+static Material gMaterial{};
+static int gTimeLoc = -1;
+static int gScreenLoc = -1;
+static double gStart = 0.0;
+static bool gReady = false;
+
+struct QuoteVerts {
+    std::vector<float> pos, uv, seedA, seedB;
+};
+
+// -----------------------------
+// Helpers
+// -----------------------------
+
+static void LoadLines(const char* path, std::vector<std::string>& out) {
+    std::ifstream f(path);
+    std::string line;
+
+    while (std::getline(f, line)) {
+        if (!line.empty())
+            out.push_back(line);
+    }
+}
+
+// Unrotated glyph quads of one quote, laid out like DrawTextPro, each
+// corner tagged with the quote's seeds
+static void AddQuote(QuoteVerts& v, const std::string& text, const float seedA[3], const float seedB[4]) {
+    Font font = GetFontDefault();
+    float scale = QUOTE_SIZE / font.baseSize;
+    float pad = (float)font.glyphPadding;
+    float tw = (float)font.texture.width;
+    float th = (float)font.texture.height;
+
+    float offsetX = 0.0f;
+
+    for (const char* p = text.c_str(); *p; ) {
+        int size = 0;
+        int codepoint = GetCodepointNext(p, &size);
+        p += size;
+
+        int index = GetGlyphIndex(font, codepoint);
+        const Rectangle& rec = font.recs[index];
+        const GlyphInfo& glyph = font.glyphs[index];
+
+        if (codepoint != ' ' && codepoint != '\t' &&
+            (int)v.pos.size() / 3 + 4 <= MAX_QUOTE_VERTS) {
+            float x0 = offsetX + glyph.offsetX * scale - pad * scale;
+            float y0 = glyph.offsetY * scale - pad * scale;
+            float x1 = x0 + (rec.width + 2.0f * pad) * scale;
+            float y1 = y0 + (rec.height + 2.0f * pad) * scale;
+
+            float u0 = (rec.x - pad) / tw;
+            float v0 = (rec.y - pad) / th;
+            float u1 = (rec.x + rec.width + pad) / tw;
+            float v1 = (rec.y + rec.height + pad) / th;
+
+            // tl, bl, br, tr like rlgl's own quads
+            const float corners[4][4] = {
+                { x0, y0, u0, v0 },
+                { x0, y1, u0, v1 },
+                { x1, y1, u1, v1 },
+                { x1, y0, u1, v0 },
+            };
+            for (const auto& c : corners) {
+                v.pos.insert(v.pos.end(), { c[0], c[1], 0.0f });
+                v.uv.insert(v.uv.end(), { c[2], c[3] });
+                v.seedA.insert(v.seedA.end(), seedA, seedA + 3);
+                v.seedB.insert(v.seedB.end(), seedB, seedB + 4);
+            }
+        }
+
+        offsetX += (glyph.advanceX == 0 ? rec.width : (float)glyph.advanceX) * scale + QUOTE_SPACING;
+    }
+}
+
+template <typename T>
+static T* CopyOut(const std::vector<T>& v) {
+    T* out = (T*)MemAlloc((unsigned int)(v.size() * sizeof(T)));
+    std::copy(v.begin(), v.end(), out);
+    return out;
+}
+
+// -----------------------------
+// Public API
+// -----------------------------
+
+void MenuQuotesInit() {
+    PROFILE_SCOPE("MenuQuotesInit");
+
+    std::vector<std::string> lines;
+    LoadLines("assets/text/stone.txt", lines);
+    LoadLines("assets/text/wind.txt", lines);
+    if (lines.empty()) return;
+
+    Rng& rng = RngGet(RNG_MENU);
+
+    QuoteVerts v;
+    for (int i = 0; i < QUOTE_COUNT; i++) {
+        const std::string& text = lines[RngInt(rng, 0, (int)lines.size() - 1)];
+
+        const float seedA[3] = {
+            RngFloat(rng),                             // start x
+            RngFloat(rng),                             // start y
+            (float)RngInt(rng, -25, 25)                // rotation
+        };
+        const float seedB[4] = {
+            RngInt(rng, -10, 10) / 10.0f,              // drift x
+            RngInt(rng, -10, 10) / 10.0f,              // drift y
+            RngInt(rng, 30, 90) / 100.0f,              // alpha
+            RngFloat(rng)                              // flicker
+        };
+        AddQuote(v, text, seedA, seedB);
+    }
+
+    int verts = (int)v.pos.size() / 3;
+    int quads = verts / 4;
+    if (quads == 0) return;
+
+    std::vector<unsigned short> indices;
+    indices.reserve(quads * 6);
+    for (int q = 0; q < quads; q++) {
+        unsigned short b = (unsigned short)(q * 4);
+        indices.insert(indices.end(), { b, (unsigned short)(b + 1), (unsigned short)(b + 2),
+                                        b, (unsigned short)(b + 2), (unsigned short)(b + 3) });
+    }
+
+    gMesh = Mesh{};
+    gMesh.vertexCount = verts;
+    gMesh.triangleCount = quads * 2;
+    gMesh.vertices = CopyOut(v.pos);
+    gMesh.texcoords = CopyOut(v.uv);
+    gMesh.normals = CopyOut(v.seedA);
+    gMesh.tangents = CopyOut(v.seedB);
+    gMesh.indices = CopyOut(indices);
+    UploadMesh(&gMesh, false);
+
+    gMaterial = LoadMaterialDefault();
+    gMaterial.shader = LoadShader(QUOTES_VS_PATH, QUOTES_FS_PATH);
+    gMaterial.maps[MATERIAL_MAP_DIFFUSE].texture = GetFontDefault().texture;
+
+    gTimeLoc = GetShaderLocation(gMaterial.shader, "time");
+    gScreenLoc = GetShaderLocation(gMaterial.shader, "screen");
+
+    gStart = ClockTime();
+    gReady = true;
+}
+
+void MenuQuotesShutdown() {
+    if (!gReady) return;
+
+    UnloadMesh(gMesh);
+
+    // not UnloadMaterial, that would take the font atlas with it
+    UnloadShader(gMaterial.shader);
+    MemFree(gMaterial.maps);
+
+    gMesh = Mesh{};
+    gMaterial = Material{};
+    gReady = false;
+}
+
+void MenuQuotesRestart() {
+    gStart = ClockTime();
+}
+
+void MenuQuotesDraw() {
+    if (!gReady) return;
+
+    float time = (float)(ClockTime() - gStart);
+    float screen[2] = { (float)GetScreenWidth(), (float)GetScreenHeight() };
+    SetShaderValue(gMaterial.shader, gTimeLoc, &time, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(gMaterial.shader, gScreenLoc, screen, SHADER_UNIFORM_VEC2);
+
+    // DrawMesh goes straight to GL, anything batched has to land first
+    rlDrawRenderBatchActive();
+
+    Matrix identity = { 1, 0, 0, 0,
+                        0, 1, 0, 0,
+                        0, 0, 1, 0,
+                        0, 0, 0, 1 };
+    DrawMesh(gMesh, gMaterial, identity);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+// The red quotes drifting behind the main menu. Every glyph quad is built
+// once into a static mesh, drift, wrap, rotation and flicker are worked out
+// in quotes.vs from the time and per-quote seeds. One draw call, no per
+// frame CPU work beyond setting two uniforms.
+
+void MenuQuotesInit();      // after InitWindow
+void MenuQuotesShutdown();
+
+// back to the start positions, on every menu entry
+void MenuQuotesRestart();
+
+// window space, inside BeginDrawing
+void MenuQuotesDraw();
@@ -0,0 +1,432 @@
+#include "mixer.h"
+#include "../config.h"
+#include "spsc.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+enum MixerOp {
+    MIX_PLAY,
+    MIX_STOP_TAG,
+    MIX_STOP_ALL,
+    MIX_SYNTH_GATE,
+    MIX_SYNTH_RELEASE
+};
+
+struct MixerCmd {
+    MixerOp op;
+    int sample;
+    float gain;
+    int priority;
+    int tag;
+    bool loop;
+    MixerSynthParams synth;
+    double postTime;
+};
+
+struct MixerSample {
+    unsigned offset;   // into gPcm
+    unsigned length;
+};
+
+enum VoiceKind {
+    VOICE_FREE,
+    VOICE_SAMPLE,
+    VOICE_SYNTH
+};
+
+struct SynthState {
+    MixerSynthParams params;
+    float re, im;       // sine phasor
+    float cr, ci;       // rotation per sample
+    uint32_t rng;
+    float lp;           // filtered noise
+    float env;
+    float attackCoef, releaseCoef;
+    bool gate;
+};
+
+struct Voice {
+    VoiceKind kind = VOICE_FREE;
+    int priority = 0;
+    int tag = MIXER_NO_TAG;
+    unsigned age = 0;  // start order, for stealing
+
+    // VOICE_SAMPLE
+    int sample = -1;
+    unsigned pos = 0;
+    float gain = 0.0f;
+    bool loop = false;
+
+    // VOICE_SYNTH
+    SynthState synth{};
+};
+
+// written before MixerStart, read only afterwards
+static std::vector<float> gPcm;
+static std::vector<MixerSample> gSamples;
+
+// game thread -> audio thread, and the event log back
+static SpscQueue<MixerCmd, 64> gCommands;
+static SpscQueue<MixerEvent, 256> gEvents;
+
+// audio thread only
+static Voice gVoices[MIXER_VOICES];
+static unsigned gAge = 0;
+static uint64_t gFrame = 0;    // output frames mixed so far
+
+static AudioStream gStream{};
+static bool gStarted = false;
+static int gBufferFrames = AUDIO_BUFFER_FRAMES;
+
+// null device
+static std::thread gLoopThread;
+static std::atomic<bool> gLoopQuit{false};
+static bool gLoopback = false;
+static MixerLoopback gLoopResult;
+
+// -----------------------------
+// Helpers
+// -----------------------------
+
+using MixerClock = std::chrono::steady_clock;
+
+static double NowSeconds() {
+    static const MixerClock::time_point start = MixerClock::now();
+    return std::chrono::duration<double>(MixerClock::now() - start).count();
+}
+
+static void Post(MixerCmd c) {
+    if (!gStarted) return;
+
+    c.postTime = NowSeconds();
+    if (!gCommands.Push(c))
+        TraceLog(LOG_WARNING, "MIXER: command queue full, dropped one");
+}
+
+// -----------------------------
+// Audio thread
+// -----------------------------
+
+static Voice* FindTagged(int tag, VoiceKind kind) {
+    if (tag == MIXER_NO_TAG) return nullptr;
+    for (Voice& v : gVoices) {
+        if (v.kind == kind && v.tag == tag) return &v;
+    }
+    return nullptr;
+}
+
+// free voice, or the one to steal, nullptr if everything matters more
+static Voice* PickVoice(int priority) {
+    Voice* pick = nullptr;
+    for (Voice& v : gVoices) {
+        if (v.kind == VOICE_FREE) return &v;
+        if (v.priority > priority) continue;
+        if (!pick || v.priority < pick->priority ||
+            (v.priority == pick->priority && v.age < pick->age)) {
+            pick = &v;
+        }
+    }
+    return pick;
+}
+
+static void StartSample(const MixerCmd& c) {
+    if (c.loop && FindTagged(c.tag, VOICE_SAMPLE)) return;
+
+    Voice* v = PickVoice(c.priority);
+    if (!v) return;
+
+    *v = Voice{};
+    v->kind = VOICE_SAMPLE;
+    v->priority = c.priority;
+    v->tag = c.tag;
+    v->age = gAge++;
+    v->sample = c.sample;
+    v->gain = c.gain;
+    v->loop = c.loop;
+}
+
+static float EnvCoef(float seconds) {
+    // one-pole, ~63% of the way there after `seconds`
+    return 1.0f - expf(-1.0f / (std::max(seconds, 0.001f) * SYNTH_SAMPLE_RATE));
+}
+
+static void TuneSynth(SynthState& s, const MixerSynthParams& p) {
+    float step = 2.0f * PI * p.freq / SYNTH_SAMPLE_RATE;
+    s.params = p;
+    s.cr = cosf(step);
+    s.ci = sinf(step);
+    s.attackCoef = EnvCoef(p.attack);
+    s.releaseCoef = EnvCoef(p.release);
+    s.gate = true;
+}
+
+static void GateSynth(const MixerCmd& c) {
+    // already running (maybe releasing), keep phase and level, no click
+    if (Voice* v = FindTagged(c.tag, VOICE_SYNTH)) {
+        TuneSynth(v->synth, c.synth);
+        v->priority = c.priority;
+        return;
+    }
+
+    Voice* v = PickVoice(c.priority);
+    if (!v) return;
+
+    *v = Voice{};
+    v->kind = VOICE_SYNTH;
+    v->priority = c.priority;
+    v->tag = c.tag;
+    v->age = gAge++;
+
+    SynthState& s = v->synth;
+    s.re = 1.0f;
+    s.im = 0.0f;
+    s.rng = 0x9e3779b9u ^ (uint32_t)(v->age * 2654435761u);
+    s.lp = 0.0f;
+    s.env = 0.0f;
+    TuneSynth(s, c.synth);
+}
+
+static void RunCommands() {
+    MixerCmd c;
+    while (gCommands.Pop(c)) {
+        // only the loopback test reads the log
+        if (gLoopback) {
+            bool onset = c.op == MIX_PLAY || c.op == MIX_SYNTH_GATE;
+            gEvents.Push(MixerEvent{ c.sample, onset, c.tag, c.postTime, NowSeconds(), gFrame });
+        }
+
+        switch (c.op) {
+            case MIX_PLAY:
+                StartSample(c);
+                break;
+
+            case MIX_STOP_TAG:
+                for (Voice& v : gVoices) {
+                    if (v.tag == c.tag) v.kind = VOICE_FREE;
+                }
+                break;
+
+            case MIX_STOP_ALL:
+                for (Voice& v : gVoices) v.kind = VOICE_FREE;
+                break;
+
+            case MIX_SYNTH_GATE:
+                GateSynth(c);
+                break;
+
+            case MIX_SYNTH_RELEASE:
+                if (Voice* v = FindTagged(c.tag, VOICE_SYNTH)) v->synth.gate = false;
+                break;
+        }
+    }
+}
+
+static void MixSample(Voice& v, float* out, unsigned frames) {
+    const MixerSample& s = gSamples[v.sample];
+    const float* pcm = gPcm.data() + s.offset;
+
+    unsigned i = 0;
+    while (i < frames) {
+        unsigned n = std::min(frames - i, s.length - v.pos);
+        for (unsigned k = 0; k < n; k++)
+            out[i + k] += pcm[v.pos + k] * v.gain;
+
+        i += n;
+        v.pos += n;
+
+        if (v.pos >= s.length) {
+            if (!v.loop) {
+                v.kind = VOICE_FREE;
+                return;
+            }
+            v.pos = 0;
+        }
+    }
+}
+
+static void MixSynth(Voice& v, float* out, unsigned frames) {
+    SynthState& s = v.synth;
+    const MixerSynthParams& p = s.params;
+
+    const float target = s.gate ? p.gain : 0.0f;
+    const float coef = s.gate ? s.attackCoef : s.releaseCoef;
+
+    for (unsigned i = 0; i < frames; i++) {
+        uint32_t x = s.rng;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        s.rng = x;
+
+        float white = (float)(int32_t)x * (1.0f / 2147483648.0f);
+        s.lp += (white - s.lp) * p.brightness;
+        s.env += (target - s.env) * coef;
+
+        out[i] += (s.im * p.toneMix + s.lp * p.noiseMix) * s.env;
+
+        float r = s.re * s.cr - s.im * s.ci;
+        s.im = s.re * s.ci + s.im * s.cr;
+        s.re = r;
+    }
+
+    // back onto the unit circle once a block is plenty
+    float g = 1.5f - 0.5f * (s.re * s.re + s.im * s.im);
+    s.re *= g;
+    s.im *= g;
+
+    if (!s.gate && s.env < 1.0e-4f) v.kind = VOICE_FREE;
+}
+
+static void MixCallback(void* buffer, unsigned int frames) {
+    RunCommands();
+
+    float* out = (float*)buffer;
+    std::fill(out, out + frames, 0.0f);
+
+    for (Voice& v : gVoices) {
+        if (v.kind == VOICE_SAMPLE) MixSample(v, out, frames);
+        else if (v.kind == VOICE_SYNTH) MixSynth(v, out, frames);
+    }
+
+    for (unsigned i = 0; i < frames; i++)
+        out[i] = std::clamp(out[i], -1.0f, 1.0f);
+
+    gFrame += frames;
+}
+
+// stands in for the device: one block per buffer period, recorded
+static void LoopbackThread(int frames) {
+    const double period = (double)frames / SYNTH_SAMPLE_RATE;
+    const double start = NowSeconds();
+    std::vector<float> block(frames);
+
+    for (uint64_t k = 0; !gLoopQuit.load(std::memory_order_relaxed); k++) {
+        double due = start + k * period;
+        double now = NowSeconds();
+
+        if (now < due) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(due - now));
+            now = NowSeconds();
+        }
+        // past the other sub-buffer too, a device would have played silence
+        if (now > due + period) gLoopResult.late++;
+
+        MixCallback(block.data(), frames);
+        gLoopResult.blockTimes.push_back(now);
+        gLoopResult.samples.insert(gLoopResult.samples.end(), block.begin(), block.end());
+    }
+}
+
+// -----------------------------
+// Public API
+// -----------------------------
+
+int MixerAddSample(const Wave& wave) {
+    if (gStarted || wave.sampleSize != 16 || wave.channels != 1 || wave.frameCount == 0) {
+        TraceLog(LOG_WARNING, "MIXER: sample rejected");
+        return -1;
+    }
+
+    MixerSample s{ (unsigned)gPcm.size(), wave.frameCount };
+
+    const short* data = (const short*)wave.data;
+    for (unsigned i = 0; i < wave.frameCount; i++)
+        gPcm.push_back(data[i] / 32768.0f);
+
+    gSamples.push_back(s);
+    return (int)gSamples.size() - 1;
+}
+
+void MixerSetBufferFrames(int frames) {
+    gBufferFrames = std::max(0, frames);
+}
+
+int MixerBufferFrames() {
+    // what raylib picks for 0
+    return gBufferFrames > 0 ? gBufferFrames : SYNTH_SAMPLE_RATE / 30;
+}
+
+void MixerStart(bool loopback) {
+    gCommands.Reset();
+    gEvents.Reset();
+    for (Voice& v : gVoices) v = Voice{};
+    gFrame = 0;
+
+    gLoopback = loopback;
+    if (loopback) {
+        gLoopResult = MixerLoopback{};
+        gLoopResult.samples.reserve(SYNTH_SAMPLE_RATE * 60);
+        gLoopQuit = false;
+        gStarted = true;
+        gLoopThread = std::thread(LoopbackThread, MixerBufferFrames());
+        return;
+    }
+
+    // only for this stream, the music keeps raylib's bigger default
+    SetAudioStreamBufferSizeDefault(gBufferFrames);
+    gStream = LoadAudioStream(SYNTH_SAMPLE_RATE, 32, 1);
+    SetAudioStreamBufferSizeDefault(0);
+
+    if (!IsAudioStreamValid(gStream)) {
+        TraceLog(LOG_WARNING, "MIXER: no audio stream, effects are off");
+        return;
+    }
+
+    gStarted = true;
+    SetAudioStreamCallback(gStream, MixCallback);
+    PlayAudioStream(gStream);
+}
+
+void MixerShutdown() {
+    if (gStarted && gLoopback) {
+        gLoopQuit = true;
+        gLoopThread.join();
+        gStarted = false;
+    }
+    if (gStarted) {
+        StopAudioStream(gStream);
+        UnloadAudioStream(gStream);
+        gStarted = false;
+    }
+
+    gPcm.clear();
+    gSamples.clear();
+}
+
+double MixerNow() {
+    return NowSeconds();
+}
+
+bool MixerPollEvent(MixerEvent& out) {
+    return gEvents.Pop(out);
+}
+
+const MixerLoopback& MixerLoopbackResult() {
+    return gLoopResult;
+}
+
+void MixerPlay(int sample, float gain, int priority, int tag, bool loop) {
+    if (sample < 0) return;
+    Post(MixerCmd{ MIX_PLAY, sample, gain, priority, tag, loop, {}, 0.0 });
+}
+
+void MixerStopTag(int tag) {
+    Post(MixerCmd{ MIX_STOP_TAG, -1, 0.0f, 0, tag, false, {}, 0.0 });
+}
+
+void MixerStopAll() {
+    Post(MixerCmd{ MIX_STOP_ALL, -1, 0.0f, 0, MIXER_NO_TAG, false, {}, 0.0 });
+}
+
+void MixerSynthGate(int tag, const MixerSynthParams& params, int priority) {
+    Post(MixerCmd{ MIX_SYNTH_GATE, -1, 0.0f, priority, tag, false, params, 0.0 });
+}
+
+void MixerSynthRelease(int tag) {
+    Post(MixerCmd{ MIX_SYNTH_RELEASE, -1, 0.0f, 0, tag, false, {}, 0.0 });
+}
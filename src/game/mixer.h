@@ -0,0 +1,73 @@
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+#include <vector>
+
+// Sound effect mixer. Samples are registered up front, then a fixed pool of
+// MIXER_VOICES voices is mixed inside raylib's stream callback on the audio
+// thread. Gameplay only posts commands into a lock-free queue, nothing here
+// blocks or needs calling every frame.
+//
+// A full pool steals the voice with the lowest priority (oldest first) if
+// it isn't above the new sound's, otherwise the new sound is dropped.
+//
+// Besides samples a voice can be a live synth: a sine plus filtered noise,
+// rendered block by block. It stays up while gated, a new gate on the same
+// tag retunes it in place, and a release fades it out, so chained moves run
+// as one continuous sound.
+
+constexpr int MIXER_NO_TAG = 0;
+
+struct MixerSynthParams {
+    float freq;         // Hz, sine part
+    float toneMix;
+    float noiseMix;
+    float brightness;   // 0..1, one-pole lowpass on the noise, 1 = white
+    float gain;         // 0..1
+    float attack;       // seconds to reach gain
+    float release;      // seconds to fade once released
+};
+
+// With loopback every command is timestamped when gameplay posts it and
+// again when the audio thread picks it up, those pairs come back through
+// MixerPollEvent. In a normal run nothing drains them, so nothing is logged.
+struct MixerEvent {
+    int sample;          // -1 for synth gates and stops
+    bool onset;          // starts a sound, a play or a synth gate
+    int tag;
+    double postTime;     // MixerNow() at the SoundOn* call
+    double submitTime;   // MixerNow() when the callback ran it
+    uint64_t frame;      // output frame it took effect on
+};
+
+// What the null device saw, for --audio-loopback
+struct MixerLoopback {
+    std::vector<float> samples;
+    std::vector<double> blockTimes;   // MixerNow() each block was rendered at
+    int late = 0;                     // blocks a real device would have underrun on
+};
+
+// 16 bit mono at SYNTH_SAMPLE_RATE, copied. Only before MixerStart
+int MixerAddSample(const Wave& wave);
+
+// before MixerStart, 0 = raylib's default
+void MixerSetBufferFrames(int frames);
+int MixerBufferFrames();
+
+// after InitAudioDevice and the samples. loopback skips the device, a thread
+// paces the callback in real time and records what it mixed
+void MixerStart(bool loopback = false);
+void MixerShutdown();
+
+double MixerNow();
+bool MixerPollEvent(MixerEvent& out);         // game thread, loopback only
+const MixerLoopback& MixerLoopbackResult();   // after MixerShutdown
+
+// tagged looping voices don't stack, a second start is ignored
+void MixerPlay(int sample, float gain, int priority, int tag = MIXER_NO_TAG, bool loop = false);
+void MixerStopTag(int tag);
+void MixerStopAll();
+
+// starts a synth voice under tag, or retunes / re-gates the one already there
+void MixerSynthGate(int tag, const MixerSynthParams& params, int priority);
+void MixerSynthRelease(int tag);
@@ -0,0 +1,250 @@
+#include "music.h"
+#include "../config.h"
+#include "spsc.h"
+#include <raylib.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+constexpr auto MUSIC_TICK = std::chrono::milliseconds(5);
+
+constexpr int MUSIC_CHANNELS = 2;
+constexpr unsigned MUSIC_BLOCK_FRAMES = 512;
+constexpr unsigned MUSIC_RING_BLOCKS = 16;   // ~190 ms at 44.1 kHz
+
+enum MusicCommand {
+    MUSIC_PLAY,
+    MUSIC_PAUSE,
+    MUSIC_STOP,
+    MUSIC_RESTART
+};
+
+enum MusicState {
+    STATE_PLAYING,
+    STATE_PAUSED,
+    STATE_STOPPED
+};
+
+struct MusicBlock {
+    unsigned generation = 0;   // bumped by stop/restart, older blocks are dropped
+    unsigned frames = 0;
+    float pcm[MUSIC_BLOCK_FRAMES * MUSIC_CHANNELS];
+};
+
+// main thread -> music thread
+static SpscQueue<MusicCommand, 16> gQueue;
+
+// music thread -> device callback
+static SpscQueue<MusicBlock, MUSIC_RING_BLOCKS> gRing;
+static std::atomic<int> gState{STATE_STOPPED};
+static std::atomic<unsigned> gGeneration{0};
+static std::atomic<unsigned> gUnderruns{0};
+
+// device callback only
+static MusicBlock gCurrent;
+static unsigned gCurrentPos = 0;
+
+static std::thread gThread;
+static bool gStarted = false;
+
+// not a queued command, a full queue mustn't be able to eat it
+static std::atomic<bool> gQuit{false};
+
+// -----------------------------
+// Helpers
+// -----------------------------
+
+static void Post(MusicCommand cmd) {
+    if (!gStarted) return;
+
+    if (!gQueue.Push(cmd))
+        TraceLog(LOG_WARNING, "MUSIC: command queue full, dropped one");
+}
+
+static Wave LoadTheme() {
+    if (FileExists(MUSIC_FILE)) {
+        Wave w = LoadWave(MUSIC_FILE);
+        if (IsWaveValid(w)) return w;
+    }
+
+    TraceLog(LOG_INFO, "MUSIC: %s missing, decoding %s", MUSIC_FILE, MUSIC_FILE_FALLBACK);
+    return LoadWave(MUSIC_FILE_FALLBACK);
+}
+
+// -----------------------------
+// Device callback
+// -----------------------------
+
+// Runs on miniaudio's thread. Never waits on anything, an empty ring just
+// plays silence until the music thread catches up.
+static void StreamCallback(void* buffer, unsigned int frames) {
+    const int state = gState.load(std::memory_order_acquire);
+    const unsigned gen = gGeneration.load(std::memory_order_acquire);
+    float* out = (float*)buffer;
+
+    while (state == STATE_PLAYING && frames > 0) {
+        if (gCurrentPos == gCurrent.frames || gCurrent.generation != gen) {
+            if (!gRing.Pop(gCurrent)) {
+                gUnderruns.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            gCurrentPos = 0;
+            continue;
+        }
+
+        unsigned n = std::min(frames, gCurrent.frames - gCurrentPos);
+        std::copy_n(gCurrent.pcm + gCurrentPos * MUSIC_CHANNELS, n * MUSIC_CHANNELS, out);
+        out += n * MUSIC_CHANNELS;
+        gCurrentPos += n;
+        frames -= n;
+    }
+
+    // blocks from before the stop, a restart shouldn't queue up behind them
+    if (state == STATE_STOPPED) {
+        while (gCurrent.generation != gen && gRing.Pop(gCurrent))
+            gCurrentPos = 0;
+    }
+
+    std::fill(out, out + frames * MUSIC_CHANNELS, 0.0f);
+}
+
+// -----------------------------
+// Music thread
+// -----------------------------
+
+// tops the ring up from the decoded theme, loops at the end. Returns the
+// number of blocks pushed.
+static unsigned Fill(const Wave& theme, unsigned& cursor, unsigned generation) {
+    const float* pcm = (const float*)theme.data;
+
+    MusicBlock block;
+    block.generation = generation;
+
+    for (unsigned pushed = 0;; pushed++) {
+        unsigned n = std::min(MUSIC_BLOCK_FRAMES, theme.frameCount - cursor);
+        block.frames = n;
+        std::copy_n(pcm + cursor * MUSIC_CHANNELS, n * MUSIC_CHANNELS, block.pcm);
+
+        if (!gRing.Push(block)) return pushed;
+        cursor = (cursor + n) % theme.frameCount;
+    }
+}
+
+static void MusicThread() {
+    // raylib has no public way to pull frames out of a Music, so the whole
+    // theme is decoded up front, here rather than on the render thread
+    Wave theme = LoadTheme();
+    AudioStream stream{};
+
+    if (IsWaveValid(theme) && theme.frameCount > 0) {
+        WaveFormat(&theme, theme.sampleRate, 32, MUSIC_CHANNELS);
+        stream = LoadAudioStream(theme.sampleRate, 32, MUSIC_CHANNELS);
+    }
+    if (!IsAudioStreamValid(stream)) {
+        TraceLog(LOG_WARNING, "MUSIC: no soundtrack");
+        UnloadWave(theme);
+
+        // keep eating commands so the queue never fills up
+        while (!gQuit.load(std::memory_order_acquire)) {
+            MusicCommand cmd;
+            while (gQueue.Pop(cmd)) {}
+            std::this_thread::sleep_for(MUSIC_TICK);
+        }
+        return;
+    }
+
+    unsigned cursor = 0;
+    unsigned gen = 0;
+    int state = STATE_PLAYING;
+    unsigned underruns = 0;
+
+    // after a restart the callback keeps playing silence until half the
+    // ring holds the new start, otherwise it would run dry straight away
+    bool restarting = false;
+    unsigned primed = 0;
+
+    Fill(theme, cursor, gen);
+    gState.store(state, std::memory_order_release);
+    SetAudioStreamCallback(stream, StreamCallback);
+    PlayAudioStream(stream);
+
+    while (!gQuit.load(std::memory_order_acquire)) {
+        MusicCommand cmd;
+        while (gQueue.Pop(cmd)) {
+            switch (cmd) {
+                // a stopped theme waits for a restart, same as raylib's Resume
+                case MUSIC_PLAY:
+                    if (state == STATE_PAUSED) state = STATE_PLAYING;
+                    break;
+                case MUSIC_PAUSE:
+                    if (state == STATE_PLAYING || restarting) state = STATE_PAUSED;
+                    restarting = false;
+                    break;
+                case MUSIC_STOP:
+                case MUSIC_RESTART:
+                    state = STATE_STOPPED;
+                    cursor = 0;
+                    restarting = cmd == MUSIC_RESTART;
+                    primed = 0;
+                    gGeneration.store(++gen, std::memory_order_release);
+                    break;
+            }
+        }
+
+        if (state != STATE_STOPPED || restarting) {
+            unsigned pushed = Fill(theme, cursor, gen);
+            if (restarting) {
+                primed += pushed;
+                if (primed >= MUSIC_RING_BLOCKS / 2) {
+                    state = STATE_PLAYING;
+                    restarting = false;
+                }
+            }
+        }
+        gState.store(state, std::memory_order_release);
+
+        unsigned seen = gUnderruns.load(std::memory_order_relaxed);
+        if (seen != underruns) {
+            TraceLog(LOG_WARNING, "MUSIC: ring ran dry (%u times so far)", seen);
+            underruns = seen;
+        }
+
+        std::this_thread::sleep_for(MUSIC_TICK);
+    }
+
+    StopAudioStream(stream);
+    UnloadAudioStream(stream);
+    UnloadWave(theme);
+}
+
+// -----------------------------
+// Public API
+// -----------------------------
+
+void MusicInit() {
+    gQueue.Reset();
+    gRing.Reset();
+    gCurrent = MusicBlock{};
+    gCurrentPos = 0;
+    gState = STATE_STOPPED;
+    gGeneration = 0;
+    gUnderruns = 0;
+
+    gQuit = false;
+    gStarted = true;
+    gThread = std::thread(MusicThread);
+}
+
+void MusicShutdown() {
+    if (!gStarted) return;
+
+    gQuit.store(true, std::memory_order_release);
+    gThread.join();
+    gStarted = false;
+}
+
+void MusicPlay()    { Post(MUSIC_PLAY); }
+void MusicPause()   { Post(MUSIC_PAUSE); }
+void MusicStop()    { Post(MUSIC_STOP); }
+void MusicRestart() { Post(MUSIC_RESTART); }
@@ -0,0 +1,17 @@
+// The soundtrack lives on its own thread. It decodes the theme once, then
+// keeps a lock-free ring of PCM blocks topped up every few ms. raylib's
+// stream callback drains the ring on the audio device thread, so a long
+// frame on the render thread (level load, resize) can't starve it. The main
+// thread only posts commands through a lock-free queue.
+//
+// MUSIC_FILE (QOA) is preferred, MUSIC_FILE_FALLBACK (the source wav) is
+// used when it's missing, see `make music`.
+
+// after InitAudioDevice, starts the thread and the theme
+void MusicInit();
+void MusicShutdown();
+
+void MusicPlay();      // resume where it paused
+void MusicPause();
+void MusicStop();
+void MusicRestart();   // from the top
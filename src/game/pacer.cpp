@@ -0,0 +1,114 @@
+#include "pacer.h"
+#include <raylib.h>
+#include <algorithm>
+
+constexpr float MONITOR_CHECK_INTERVAL = 1.0f;   // seconds
+constexpr float LATENCY_SMOOTHING      = 0.05f;  // EMA weight per frame
+
+static int gMonitor = -1;
+static int gRefresh = 0;      // Hz of the monitor we're on, 0 if unknown
+static int gRate = TARGET_FPS;
+static bool gIdle = false;
+
+static double gFrameStart = 0.0;
+static float gMonitorTimer = 0.0f;
+static float gLatencyMs = 0.0f;
+
+// -----------------------------
+// Helpers
+// -----------------------------
+
+static int WantedRate() {
+    if (gIdle) return IDLE_FPS;
+
+#if FRAME_PACING == PACE_UNCAPPED
+    return 0;
+#elif FRAME_PACING == PACE_DISPLAY
+    // some drivers report 0, and nobody wants 30 Hz from a TV
+    return gRefresh >= TARGET_FPS ? gRefresh : TARGET_FPS;
+#else
+    return TARGET_FPS;
+#endif
+}
+
+static void Apply() {
+    int rate = WantedRate();
+    if (rate == gRate) return;
+
+    gRate = rate;
+    SetTargetFPS(rate);
+    TraceLog(LOG_INFO, "PACER: %s, %d fps", PacerModeName(), rate);
+}
+
+static void CheckMonitor() {
+    int monitor = GetCurrentMonitor();
+    if (monitor == gMonitor) return;
+
+    gMonitor = monitor;
+    gRefresh = GetMonitorRefreshRate(monitor);
+}
+
+// -----------------------------
+// Public API
+// -----------------------------
+
+void PacerInit() {
+    CheckMonitor();
+    gRate = -1;
+    Apply();
+}
+
+void PacerSetIdle(bool idle) {
+    gIdle = idle;
+    Apply();
+}
+
+void PacerFrameBegin() {
+    gFrameStart = GetTime();
+
+    gMonitorTimer += GetFrameTime();
+    if (gMonitorTimer >= MONITOR_CHECK_INTERVAL) {
+        gMonitorTimer = 0.0f;
+        CheckMonitor();
+        Apply();
+    }
+}
+
+void PacerFrameEnd() {
+    float work = (float)(GetTime() - gFrameStart);
+    float frame = GetFrameTime();
+    float refresh = gRefresh > 0 ? 1.0f / gRefresh : 1.0f / TARGET_FPS;
+
+    // input waits half a frame on average for the next poll, then the frame's
+    // work, then (no vsync) scanout reaches the middle of the screen after
+    // half a refresh
+    float estimate = (0.5f * frame + work + 0.5f * refresh) * 1000.0f;
+
+    gLatencyMs = gLatencyMs == 0.0f
+        ? estimate
+        : gLatencyMs + (estimate - gLatencyMs) * LATENCY_SMOOTHING;
+}
+
+int PacerRate() {
+    return std::max(0, gRate);
+}
+
+float PacerBudget() {
+    return gRate > 0 ? 1.0f / gRate : 1.0f / TARGET_FPS;
+}
+
+float PacerLatencyMs() {
+    return gLatencyMs;
+}
+
+const char* PacerModeName() {
+    if (gIdle) return "idle";
+
+#if FRAME_PACING == PACE_UNCAPPED
+    return "uncapped";
+#elif FRAME_PACING == PACE_DISPLAY
+    return "display";
+#else
+    return "fixed";
+#endif
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include "../config.h"
+
+// Frame pacing. Picks the frame rate (fixed TARGET_FPS, the monitor's refresh
+// rate or uncapped, see FRAME_PACING) and estimates input-to-photon latency.
+//
+// raylib's EndDrawing already does swap -> wait -> poll input, so input is
+// sampled right before the next simulation step. That order is kept on
+// purpose: polling again after our own wait would eat IsKeyPressed edges.
+
+void PacerInit();
+
+// follows the window onto another monitor, and the idle throttle
+void PacerSetIdle(bool idle);
+
+// right after input was polled (top of the loop) / right before EndDrawing
+void PacerFrameBegin();
+void PacerFrameEnd();
+
+int PacerRate();              // frames per second we aim for, 0 = uncapped
+float PacerBudget();          // seconds per frame, TARGET_FPS based when uncapped
+float PacerLatencyMs();       // smoothed input-to-photon estimate
+const char* PacerModeName();
@@ -0,0 +1,108 @@
+#include "particles.h"
+
+// -----------------------------
+// Helpers
+// -----------------------------
+
+static inline uint32_t XorShift(uint32_t x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+// -----------------------------
+// Public API
+// -----------------------------
+
+void ParticlesResize(Particles& p, int count, uint32_t seed) {
+    p.count = count;
+
+    p.x.assign(count, 0.0f);
+    p.y.assign(count, 0.0f);
+    p.vx.assign(count, 0.0f);
+    p.vy.assign(count, 0.0f);
+    p.life.assign(count, 0.0f);
+    p.rage.assign(count, 0.0f);
+    p.size.assign(count, 0.0f);
+    p.ox.assign(count, 0.0f);
+    p.oy.assign(count, 0.0f);
+    p.payload.assign(count, 0);
+
+    p.rng.resize(count);
+    for (int i = 0; i < count; i++) {
+        // murmur finaliser, neighbours start far apart
+        uint32_t z = seed + 0x9e3779b9u * (uint32_t)(i + 1);
+        z = (z ^ (z >> 16)) * 0x85ebca6bu;
+        z = (z ^ (z >> 13)) * 0xc2b2ae35u;
+        p.rng[i] = (z ^ (z >> 16)) | 1u;
+    }
+}
+
+uint32_t ParticleRand(Particles& p, int i) {
+    return p.rng[i] = XorShift(p.rng[i]);
+}
+
+float ParticleRange(Particles& p, int i, float lo, float hi) {
+    return lo + (hi - lo) * (ParticleRand(p, i) >> 8) * (1.0f / 16777216.0f);
+}
+
+void ParticlesIntegrate(Particles& p, float dt, float damping) {
+    const int n = p.count;
+    float* x = p.x.data();
+    float* y = p.y.data();
+    float* vx = p.vx.data();
+    float* vy = p.vy.data();
+
+    for (int i = 0; i < n; i++) {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        vx[i] *= damping;
+        vy[i] *= damping;
+    }
+}
+
+void ParticlesNudge(Particles& p, float chance, float kx, float ky) {
+    const int n = p.count;
+    // one draw per particle: low 16 bits roll the chance, the rest are the kick
+    const uint32_t threshold = (uint32_t)(chance * 65536.0f);
+    const float sx = kx / 127.5f;
+    const float sy = ky / 127.5f;
+
+    uint32_t* rng = p.rng.data();
+    float* vx = p.vx.data();
+    float* vy = p.vy.data();
+
+    for (int i = 0; i < n; i++) {
+        uint32_t r = XorShift(rng[i]);
+        rng[i] = r;
+
+        float hit = (r & 0xffffu) < threshold ? 1.0f : 0.0f;
+        vx[i] += hit * (((r >> 16) & 0xffu) * sx - kx);
+        vy[i] += hit * ((r >> 24) * sy - ky);
+    }
+}
+
+void ParticlesWrap(Particles& p, Rectangle bounds) {
+    const int n = p.count;
+    const float x0 = bounds.x, x1 = bounds.x + bounds.width;
+    const float y0 = bounds.y, y1 = bounds.y + bounds.height;
+
+    float* x = p.x.data();
+    float* y = p.y.data();
+
+    for (int i = 0; i < n; i++) {
+        // branchless so it stays one vector loop
+        // int difference of the compares, gcc if-converts the float one
+        // into branches and gives up on the loop
+        x[i] += bounds.width  * (float)((x[i] < x0) - (x[i] > x1));
+        y[i] += bounds.height * (float)((y[i] < y0) - (y[i] > y1));
+    }
+}
+
+void ParticlesAge(Particles& p, float dt) {
+    const int n = p.count;
+    float* life = p.life.data();
+    for (int i = 0; i < n; i++)
+        life[i] -= dt;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+#include <vector>
+
+// Structure-of-arrays particles. Every field is its own array, so the update
+// kernels are plain loops over floats that gcc vectorises with the makefile's
+// OPT flags (SSE2 on x86-64, no intrinsics), and every particle has its own
+// xorshift state so random kicks don't queue up on one generator.
+// What a particle draws as is up to the owner, payload indexes its pool.
+
+struct Particles {
+    int count = 0;
+    std::vector<float> x, y;
+    std::vector<float> vx, vy;
+    std::vector<float> life;      // seconds left
+    std::vector<float> rage;      // 0..1, owner defined
+    std::vector<float> size;
+    std::vector<float> ox, oy;    // draw offset / direction, owner defined
+    std::vector<uint32_t> rng;
+    std::vector<uint16_t> payload;
+};
+
+void ParticlesResize(Particles& p, int count, uint32_t seed);
+
+// next random of particle i
+uint32_t ParticleRand(Particles& p, int i);
+float ParticleRange(Particles& p, int i, float lo, float hi);
+
+// pos += vel * dt, vel *= damping
+void ParticlesIntegrate(Particles& p, float dt, float damping);
+
+// with probability chance each, vel += uniform(-kx..kx, -ky..ky)
+void ParticlesNudge(Particles& p, float chance, float kx, float ky);
+
+// toroidal, anything that left one side comes back on the other
+void ParticlesWrap(Particles& p, Rectangle bounds);
+
+void ParticlesAge(Particles& p, float dt);
@@ -1,4 +1,5 @@
 #include "player.h"
+#include "anim.h"
 
 void PlayerInit(Player* p, int x, int y, const View& view) {
     p->gx = x;
@@ -13,6 +14,7 @@ void PlayerInit(Player* p, int x, int y, const View& view) {
     p->moving = false;
 
     p->mask = MASK_NONE;
+    p->slideStep = 0;
     p->facing = DIR_DOWN;
     p->animTime = 0.0f;
 }
@@ -23,7 +25,7 @@ void PlayerReset(Player* p, int x, int y, const View& view) {
 
 
 static void StartMove(Player* p, int nx, int ny, const View& view) {
-    SoundOnMoveStart(p->mask);
+    SoundOnMoveStart(p->mask, p->slideStep);
 
     p->gx = nx;
     p->gy = ny;
@@ -63,6 +65,7 @@ void PlayerTryMove(
        // return;
         //}
 
+    p->slideStep = 0;
     StartMove(p, nx, ny, view);
     if (dx > 0) p->facing = DIR_RIGHT; 
     else if (dx < 0) p->facing = DIR_LEFT;
@@ -91,7 +94,6 @@ void PlayerUpdate(Player* p, float dt, const World& world, const View& view) {
 
     if (t >= 1.0f) {
         t = 1.0f;
-        SoundOnMoveStop(p->mask);
         p->moving = false;
         p->visualPos = p->targetPos;
 
@@ -105,6 +107,8 @@ void PlayerUpdate(Player* p, float dt, const World& world, const View& view) {
                 int ny = p->gy + dy;
 
                 if (world.IsWalkable(nx, ny, p->mask)) {
+                    // the move sound carries on, no stop/start between steps
+                    p->slideStep++;
                     StartMove(p, nx, ny, view);
                     return;
                 }
@@ -112,6 +116,8 @@ void PlayerUpdate(Player* p, float dt, const World& world, const View& view) {
 
             p->slideDir = { 0, 0 }; // stop sliding
         }
+
+        SoundOnMoveStop(p->mask);
     }
 
     float smooth = t * t * (3.0f - 2.0f * t);
@@ -119,85 +125,27 @@ void PlayerUpdate(Player* p, float dt, const World& world, const View& view) {
     p->visualPos.y = p->startPos.y + (p->targetPos.y - p->startPos.y) * smooth;
 }
 
-std::unordered_map<MaskType, MaskAnimations> gMaskAnims;
+// [mask][facing][moving], ANIM_NONE where there's no sheet (MASK_NONE)
+constexpr int MASK_COUNT = MASK_WIND + 1;
+static int gPlayerClips[MASK_COUNT][4][2];
 
 void InitMaskAnimations() {
-    gMaskAnims[MASK_STONE] = {
-        // UP
-        {
-            { LoadTexture("assets/player/STONE_UP_IDLE.png"), 11, 3 },
-            { LoadTexture("assets/player/STONE_UP_WALK.png"), 4, 2 }
-        },
-        // DOWN
-        {
-            { LoadTexture("assets/player/STONE_DOWN_IDLE.png"), 14, 4 },
-            { LoadTexture("assets/player/STONE_DOWN_WALK.png"), 8, 3 }
-        },
-        // LEFT
-        {
-            { LoadTexture("assets/player/STONE_LEFT_IDLE.png"), 1, 2 },
-            { LoadTexture("assets/player/STONE_LEFT_WALK.png"), 4, 2 }
-        },
-        // RIGHT
-        {
-            { LoadTexture("assets/player/STONE_RIGHT_IDLE.png"), 1, 2 },
-            { LoadTexture("assets/player/STONE_RIGHT_WALK.png"), 4, 2 }
-        }
-    };
-    gMaskAnims[MASK_WIND] = {
-        // UP
-        {
-            { LoadTexture("assets/player/WIND_IDLE.png"), 6, 2 },
-            { LoadTexture("assets/player/WIND_UP_WALK.png"), 6, 2 }
-        },
-        // DOWN
-        {
-            { LoadTexture("assets/player/WIND_IDLE.png"), 6, 2 },
-            { LoadTexture("assets/player/WIND_DOWN_WALK.png"), 6, 2 }
-        },
-        // LEFT
-        {
-            { LoadTexture("assets/player/WIND_IDLE.png"), 6, 2 },
-            { LoadTexture("assets/player/WIND_LEFT_WALK.png"), 6, 2 }
-        },
-        // RIGHT
-        {
-            { LoadTexture("assets/player/WIND_IDLE.png"), 6, 2 },
-            { LoadTexture("assets/player/WIND_RIGHT_WALK.png"), 6, 2 }
+    static const char* DIR_NAMES[4] = { "up", "down", "left", "right" };
+
+    for (int m = 0; m < MASK_COUNT; m++) {
+        for (int d = 0; d < 4; d++) {
+            for (int moving = 0; moving < 2; moving++) {
+                const char* name = TextFormat("%s_%s_%s", MaskName((MaskType)m),
+                                              DIR_NAMES[d], moving ? "walk" : "idle");
+                gPlayerClips[m][d][moving] = AnimFind(name);
+            }
         }
-    };
-}
-
-int GetAnimFrame(const Player& p, const Anim& anim) {
-    if (anim.numFrames <= 1) return 0;
-
-    int frame = (int)(p.animTime * Anim::fps);
-    return frame % anim.numFrames;
+    }
 }
 
 void PlayerDraw(const Player* p, const View& view) {
-    const MaskAnimations& anims = gMaskAnims[p->mask];
-    const AnimPair* pair = nullptr;
-
-    switch (p->facing) {
-        case DIR_UP:    pair = &anims.up; break;
-        case DIR_DOWN:  pair = &anims.down; break;
-        case DIR_LEFT:  pair = &anims.left; break;
-        case DIR_RIGHT: pair = &anims.right; break;
-    }
-
-    const Anim& anim = p->moving ? pair->walk : pair->idle;
-    int frame = GetAnimFrame(*p, anim);
-
-    int col = frame % anim.columns;
-    int row = frame / anim.columns;
-
-    Rectangle src = {
-        (float)(col * Anim::frameW),
-        (float)(row * Anim::frameH),
-        (float)Anim::frameW,
-        (float)Anim::frameH
-    };
+    int clip = gPlayerClips[p->mask][p->facing][p->moving ? 1 : 0];
+    if (clip == ANIM_NONE) return;
 
     Rectangle dst = {
         p->visualPos.x,
@@ -206,14 +154,7 @@ void PlayerDraw(const Player* p, const View& view) {
         (float)view.tileSize
     };
 
-    DrawTexturePro(
-        anim.texture,
-        src,
-        dst,
-        Vector2{0, 0},
-        0.0f,
-        WHITE
-    );
+    AnimDraw(clip, AnimFrameAt(clip, p->animTime), dst);
 }
 
 void PlayerSyncVisual(Player* p, const View& view) {
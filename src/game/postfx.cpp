@@ -0,0 +1,416 @@
+#include "postfx.h"
+#include "../config.h"
+#include "profile.h"
+#include "clock.h"
+#include "pacer.h"
+#include <rlgl.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// same deal as frameprof, linux libGL exports the query entry points.
+// Elsewhere the controller only sees CPU time.
+#if defined(__linux__)
+#define GL_GLEXT_PROTOTYPES
+#include <GL/gl.h>
+#include <GL/glext.h>
+#define POSTFX_GPU 1
+#else
+#define POSTFX_GPU 0
+#endif
+
+static const char* CRT_SHADER_PATH = "assets/shaders/crt.fs";
+
+struct QualityTier {
+    int effects;
+    int divisor;       // extra internal resolution divisor
+    const char* name;
+};
+
+// best first, the controller walks this list in both directions
+static const QualityTier TIERS[] = {
+    { FX_ALL,                              1, "full"    },
+    { FX_ALL & ~(FX_CHROMA | FX_DITHER),   1, "reduced" },
+    { FX_SCANLINES | FX_VIGNETTE,          2, "low"     },
+    { 0,                                   2, "minimal" },
+};
+constexpr int TIER_COUNT = sizeof(TIERS) / sizeof(TIERS[0]);
+
+// controller tuning
+constexpr int   QUALITY_WINDOW     = 30;     // frames per verdict
+constexpr float QUALITY_COOLDOWN   = 2.0f;   // seconds between tier changes
+constexpr float QUALITY_CALM_START = 5.0f;   // seconds of headroom before stepping up
+constexpr float QUALITY_CALM_MAX   = 60.0f;
+constexpr float QUALITY_HITCH      = 0.25f;  // level loads etc, not a render problem
+constexpr int   GPU_LAG            = 4;      // timestamp pairs in flight
+
+// lookup textures, sizes have to match the constants in crt.fs
+constexpr int WARP_LUT_SIZE = 256;
+constexpr int SCAN_LUT_SIZE = 32;    // texels per scanline period
+constexpr int NOISE_SIZE    = 64;
+
+struct ShaderVariant {
+    Shader shader;
+    int jitterLoc;
+    int resLoc;
+    int regionLoc;
+    int warpLoc;
+    int scanLoc;
+    int noiseLoc;
+};
+
+static char* gSource = nullptr;
+static std::unordered_map<int, ShaderVariant> gVariants;
+
+static Texture2D gWarpLut{};
+static Texture2D gScanLut{};
+static Texture2D gNoiseTex{};
+
+static int gAllowed = FX_ALL;  // compile time caps from config.h
+static int gTier = 0;
+
+static double gFrameStart = 0.0;
+static int gWindowFrames = 0;
+static int gWindowOver = 0;
+static float gCalm = 0.0f;
+static float gCalmNeeded = QUALITY_CALM_START;
+static float gCooldown = 0.0f;
+static float gSinceStepUp = 1e9f;
+
+// Timestamps rather than GL_TIME_ELAPSED, the frameprof scopes inside the
+// scene already use elapsed queries and those don't nest
+struct GpuStamp {
+    unsigned int begin = 0;
+    unsigned int end = 0;
+    bool pending = false;
+};
+
+static GpuStamp gStamps[GPU_LAG];
+static int gStampNext = 0;
+static int gStampOpen = -1;
+static float gGpuWork = -1.0f;  // seconds, latest result, -1 = none yet
+
+// -----------------------------
+// Lookup textures
+// -----------------------------
+
+// GLSL smoothstep, edges may be reversed like the vignette uses them
+static float Smoothstep(float e0, float e1, float x) {
+    float t = std::clamp((x - e0) / (e1 - e0), 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+static float Vignette(float u, float v) {
+    return Smoothstep(0.85f, CRT_VIGNETTE, hypotf(u - 0.5f, v - 0.5f));
+}
+
+// Curvature and vignette only depend on uv, not on the resolution, so this
+// is built once and never has to follow a resize
+static Texture2D BuildWarpLut() {
+    std::vector<float> px(WARP_LUT_SIZE * WARP_LUT_SIZE * 4);
+
+    for (int y = 0; y < WARP_LUT_SIZE; y++) {
+        for (int x = 0; x < WARP_LUT_SIZE; x++) {
+            // texel centres land on 0 and 1, see the lookup in crt.fs
+            float u = x / (float)(WARP_LUT_SIZE - 1);
+            float v = y / (float)(WARP_LUT_SIZE - 1);
+
+            float cx = u * 2.0f - 1.0f;
+            float cy = v * 2.0f - 1.0f;
+            float k = 1.0f + CRT_CURVATURE * (cx * cx + cy * cy) * 2.0f;
+            float wu = cx * k * 0.5f + 0.5f;
+            float wv = cy * k * 0.5f + 0.5f;
+
+            float* p = &px[(y * WARP_LUT_SIZE + x) * 4];
+            p[0] = wu;
+            p[1] = wv;
+            p[2] = Vignette(wu, wv);
+            p[3] = Vignette(u, v);
+        }
+    }
+
+    Image img = { px.data(), WARP_LUT_SIZE, WARP_LUT_SIZE, 1, PIXELFORMAT_UNCOMPRESSED_R32G32B32A32 };
+    Texture2D tex = LoadTextureFromImage(img);
+    SetTextureFilter(tex, TEXTURE_FILTER_BILINEAR);
+    SetTextureWrap(tex, TEXTURE_WRAP_CLAMP);
+    return tex;
+}
+
+// one period of sin(y * pi) over two screen pixels
+static Texture2D BuildScanLut() {
+    unsigned char px[SCAN_LUT_SIZE];
+    for (int i = 0; i < SCAN_LUT_SIZE; i++) {
+        float s = sinf(2.0f * PI * (i + 0.5f) / SCAN_LUT_SIZE);
+        px[i] = (unsigned char)std::lround((s * 0.5f + 0.5f) * 255.0f);
+    }
+
+    Image img = { px, 1, SCAN_LUT_SIZE, 1, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE };
+    Texture2D tex = LoadTextureFromImage(img);
+    SetTextureFilter(tex, TEXTURE_FILTER_BILINEAR);
+    SetTextureWrap(tex, TEXTURE_WRAP_REPEAT);
+    return tex;
+}
+
+static Texture2D BuildNoiseTex() {
+    unsigned char px[NOISE_SIZE * NOISE_SIZE];
+
+    // small integer hash, fixed so the dither pattern never changes
+    uint32_t h = 0x9E3779B9u;
+    for (int i = 0; i < NOISE_SIZE * NOISE_SIZE; i++) {
+        h ^= h << 13;
+        h ^= h >> 17;
+        h ^= h << 5;
+        px[i] = (unsigned char)(h >> 24);
+    }
+
+    Image img = { px, NOISE_SIZE, NOISE_SIZE, 1, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE };
+    Texture2D tex = LoadTextureFromImage(img);
+    SetTextureFilter(tex, TEXTURE_FILTER_POINT);
+    SetTextureWrap(tex, TEXTURE_WRAP_REPEAT);
+    return tex;
+}
+
+// -----------------------------
+// Variants
+// -----------------------------
+
+static ShaderVariant CompileVariant(int fx) {
+    PROFILE_SCOPE("PostFX compile variant");
+
+    std::string src = gSource;
+
+    // defines have to come after #version
+    std::string defs;
+    if (fx & FX_JITTER)    defs += "#define FX_JITTER\n";
+    if (fx & FX_CURVATURE) defs += "#define FX_CURVATURE\n";
+    if (fx & FX_CHROMA)    defs += "#define FX_CHROMA\n";
+    if (fx & FX_SCANLINES) defs += "#define FX_SCANLINES\n";
+    if (fx & FX_DITHER)    defs += "#define FX_DITHER\n";
+    if (fx & FX_VIGNETTE)  defs += "#define FX_VIGNETTE\n";
+
+    size_t eol = src.find('\n');
+    src.insert(eol == std::string::npos ? src.size() : eol + 1, defs);
+
+    ShaderVariant v;
+    v.shader = LoadShaderFromMemory(nullptr, src.c_str());
+    v.jitterLoc = GetShaderLocation(v.shader, "jitterOffset");
+    v.resLoc    = GetShaderLocation(v.shader, "resolution");
+    v.regionLoc = GetShaderLocation(v.shader, "region");
+    v.warpLoc   = GetShaderLocation(v.shader, "warpLut");
+    v.scanLoc   = GetShaderLocation(v.shader, "scanLut");
+    v.noiseLoc  = GetShaderLocation(v.shader, "noiseTex");
+
+    // curvature and vignette are baked into the warp LUT
+    SetShaderValue(v.shader, GetShaderLocation(v.shader, "scanlineIntensity"), &CRT_SCANLINE_INTENSITY, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(v.shader, GetShaderLocation(v.shader, "ditherStrength"),    &DITHER_STRENGTH,        SHADER_UNIFORM_FLOAT);
+    SetShaderValue(v.shader, GetShaderLocation(v.shader, "chromAberration"),   &CHROM_ABERRATION,       SHADER_UNIFORM_FLOAT);
+
+    return v;
+}
+
+// newest finished pair wins, results land a few frames after the fact
+static void CollectGpu() {
+#if POSTFX_GPU
+    // oldest first, gStampNext is the slot that was written longest ago
+    for (int i = 0; i < GPU_LAG; i++) {
+        GpuStamp& s = gStamps[(gStampNext + i) % GPU_LAG];
+        if (!s.pending) continue;
+
+        GLint ready = 0;
+        glGetQueryObjectiv(s.end, GL_QUERY_RESULT_AVAILABLE, &ready);
+        if (!ready) continue;
+
+        GLuint64 t0 = 0, t1 = 0;
+        glGetQueryObjectui64v(s.begin, GL_QUERY_RESULT, &t0);
+        glGetQueryObjectui64v(s.end, GL_QUERY_RESULT, &t1);
+        gGpuWork = t1 > t0 ? (t1 - t0) / 1.0e9f : 0.0f;
+        s.pending = false;
+    }
+#endif
+}
+
+static ShaderVariant& GetVariant(int fx) {
+    auto it = gVariants.find(fx);
+    if (it == gVariants.end())
+        it = gVariants.emplace(fx, CompileVariant(fx)).first;
+    return it->second;
+}
+
+// -----------------------------
+// Public API
+// -----------------------------
+
+void PostFXInit() {
+    gSource = LoadFileText(CRT_SHADER_PATH);
+
+#if !ENABLE_CRT
+    gAllowed = 0;
+#elif !ENABLE_DITHER
+    gAllowed = FX_ALL & ~FX_DITHER;
+#endif
+
+    gTier = 0;
+
+    gWarpLut  = BuildWarpLut();
+    gScanLut  = BuildScanLut();
+    gNoiseTex = BuildNoiseTex();
+
+    // warm every tier up front so stepping never hitches
+    for (int i = 0; i < TIER_COUNT; i++) {
+        int fx = TIERS[i].effects & gAllowed;
+        if (fx) GetVariant(fx);
+    }
+}
+
+void PostFXShutdown() {
+    for (auto& [fx, v] : gVariants)
+        UnloadShader(v.shader);
+    gVariants.clear();
+
+    UnloadTexture(gWarpLut);
+    UnloadTexture(gScanLut);
+    UnloadTexture(gNoiseTex);
+
+    UnloadFileText(gSource);
+    gSource = nullptr;
+
+#if POSTFX_GPU
+    for (auto& s : gStamps) {
+        if (s.begin) glDeleteQueries(1, &s.begin);
+        if (s.end) glDeleteQueries(1, &s.end);
+        s = GpuStamp{};
+    }
+#endif
+    gStampOpen = -1;
+    gGpuWork = -1.0f;
+}
+
+void PostFXFrameBegin() {
+    gFrameStart = GetTime();
+}
+
+void PostFXGpuBegin() {
+#if POSTFX_GPU
+    // all slots still in flight, skip this frame rather than stall on one
+    GpuStamp& s = gStamps[gStampNext];
+    if (s.pending) return;
+
+    if (!s.begin) glGenQueries(1, &s.begin);
+    if (!s.end) glGenQueries(1, &s.end);
+
+    // whatever is still batched isn't ours
+    rlDrawRenderBatchActive();
+    glQueryCounter(s.begin, GL_TIMESTAMP);
+    gStampOpen = gStampNext;
+#endif
+}
+
+void PostFXGpuEnd() {
+#if POSTFX_GPU
+    if (gStampOpen < 0) return;
+
+    // the CRT blit is usually still sitting in the batch
+    rlDrawRenderBatchActive();
+    glQueryCounter(gStamps[gStampOpen].end, GL_TIMESTAMP);
+    gStamps[gStampOpen].pending = true;
+
+    gStampNext = (gStampOpen + 1) % GPU_LAG;
+    gStampOpen = -1;
+#endif
+}
+
+bool PostFXFrameEnd(float frameTime) {
+    float work = (float)(GetTime() - gFrameStart);
+    CollectGpu();
+
+    if (frameTime > QUALITY_HITCH) return false;
+
+    // follows the pacer, 144 Hz leaves a lot less room than 60
+    const float budget = PacerBudget();
+
+    gCooldown -= frameTime;
+    gSinceStepUp += frameTime;
+
+    // frameTime includes the vsync/fps wait, so only overshooting it means
+    // a missed frame; work is what we spent before handing off to the GPU,
+    // gpu is what the scene and CRT pass cost on the other side
+    float gpu = std::max(gGpuWork, 0.0f);
+    bool over     = frameTime > budget * 1.2f || work > budget * 0.9f || gpu > budget * 0.9f;
+    bool headroom = frameTime < budget * 1.1f && work < budget * 0.5f && gpu < budget * 0.5f;
+
+    gWindowFrames++;
+    if (over) gWindowOver++;
+    gCalm = headroom ? gCalm + frameTime : 0.0f;
+
+    if (gWindowFrames >= QUALITY_WINDOW) {
+        bool slow = gWindowOver * 4 >= gWindowFrames;
+        gWindowFrames = gWindowOver = 0;
+
+        if (slow && gCooldown <= 0.0f && gTier < TIER_COUNT - 1) {
+            // fell straight back down, wait longer before trying again
+            if (gSinceStepUp < QUALITY_CALM_START * 2.0f)
+                gCalmNeeded = std::min(gCalmNeeded * 2.0f, QUALITY_CALM_MAX);
+
+            gTier++;
+            gCooldown = QUALITY_COOLDOWN;
+            gCalm = 0.0f;
+            TraceLog(LOG_INFO, "POSTFX: quality down to '%s'", TIERS[gTier].name);
+            return true;
+        }
+    }
+
+    if (gCalm >= gCalmNeeded && gCooldown <= 0.0f && gTier > 0) {
+        gTier--;
+        gCooldown = QUALITY_COOLDOWN;
+        gCalm = 0.0f;
+        gSinceStepUp = 0.0f;
+        TraceLog(LOG_INFO, "POSTFX: quality up to '%s'", TIERS[gTier].name);
+        return true;
+    }
+
+    return false;
+}
+
+void PostFXBegin(Vector2 resolution, Vector4 region) {
+    int fx = PostFXEffects();
+    if (!fx) return;
+
+    ShaderVariant& v = GetVariant(fx);
+
+    // the wobble is the same for every pixel, no point doing it per fragment
+    float time = (float)ClockTime();
+    Vector2 jitter = {
+        sinf(time * JITTER_SPEED) * JITTER_STRENGTH / resolution.x,
+        cosf(time * JITTER_SPEED * 0.7f) * JITTER_STRENGTH / resolution.y
+    };
+
+    SetShaderValue(v.shader, v.jitterLoc, &jitter, SHADER_UNIFORM_VEC2);
+    SetShaderValue(v.shader, v.resLoc, &resolution, SHADER_UNIFORM_VEC2);
+    SetShaderValue(v.shader, v.regionLoc, &region, SHADER_UNIFORM_VEC4);
+
+    BeginShaderMode(v.shader);
+
+    // samplers have to be set while the shader is active
+    SetShaderValueTexture(v.shader, v.warpLoc, gWarpLut);
+    SetShaderValueTexture(v.shader, v.scanLoc, gScanLut);
+    SetShaderValueTexture(v.shader, v.noiseLoc, gNoiseTex);
+}
+
+void PostFXEnd() {
+    if (PostFXEffects()) EndShaderMode();
+}
+
+int PostFXTier() {
+    return gTier;
+}
+
+int PostFXEffects() {
+    return TIERS[gTier].effects & gAllowed;
+}
+
+int PostFXResolutionDivisor() {
+    return TIERS[gTier].divisor;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <raylib.h>
+
+// CRT post-processing with runtime quality tiers. Every combination of
+// effects is its own shader variant (FX_* defines in crt.fs). A controller
+// watches CPU and GPU frame time and steps the tier down, or back up, to
+// hold TARGET_FPS.
+
+enum PostFXEffect {
+    FX_JITTER    = 1 << 0,
+    FX_CURVATURE = 1 << 1,
+    FX_CHROMA    = 1 << 2,
+    FX_SCANLINES = 1 << 3,
+    FX_DITHER    = 1 << 4,
+    FX_VIGNETTE  = 1 << 5,
+
+    FX_ALL = FX_JITTER | FX_CURVATURE | FX_CHROMA | FX_SCANLINES | FX_DITHER | FX_VIGNETTE
+};
+
+// lifecycle
+void PostFXInit();
+void PostFXShutdown();
+
+// frame timing, Begin at the top of the frame, End right before EndDrawing.
+// End returns true when the tier changed and the internal resolution may
+// have to follow (see PostFXResolutionDivisor).
+void PostFXFrameBegin();
+bool PostFXFrameEnd(float frameTime);
+
+// GPU timestamps around the scene and the CRT pass. The result comes back a
+// few frames late and feeds the same controller. No-op without GL queries.
+void PostFXGpuBegin();
+void PostFXGpuEnd();
+
+// wraps the fullscreen blit of the render target, region is the part of
+// the texture that holds the frame (see RTPoolRegion)
+void PostFXBegin(Vector2 resolution, Vector4 region);
+void PostFXEnd();
+
+int PostFXTier();
+int PostFXEffects();
+int PostFXResolutionDivisor();
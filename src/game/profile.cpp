@@ -0,0 +1,183 @@
+#include "profile.h"
+
+#if ENABLE_PROFILE
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+static const char* PROFILE_SUMMARY_FILE = "profile_summary.json";
+static const char* PROFILE_TRACE_FILE   = "profile_trace.json";
+
+// a long session would otherwise grow the trace forever, later events drop
+constexpr size_t PROFILE_MAX_EVENTS = 1 << 16;
+
+using ProfileClock = std::chrono::steady_clock;
+
+struct ProfileEvent {
+    const char* name;
+    int tid;
+    int64_t startUs;
+    int64_t durUs;   // -1 for instant events
+};
+
+struct OpenScope {
+    const char* name;
+    int64_t startUs;
+};
+
+static ProfileClock::time_point gEpoch = ProfileClock::now();
+
+static std::mutex gProfileMutex;
+static std::vector<ProfileEvent> gEvents;
+static size_t gDropped = 0;
+static int gNextTid = 0;
+
+// set once in ProfileInit, read-only after
+static bool gRecording = false;
+
+static thread_local std::vector<OpenScope> tStack;
+static thread_local int tTid = -1;
+
+// -----------------------------
+// Helpers
+// -----------------------------
+
+static int64_t NowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        ProfileClock::now() - gEpoch).count();
+}
+
+static int ThreadId() {
+    if (tTid < 0) {
+        std::lock_guard<std::mutex> lock(gProfileMutex);
+        tTid = gNextTid++;
+    }
+    return tTid;
+}
+
+static void Push(const ProfileEvent& e) {
+    std::lock_guard<std::mutex> lock(gProfileMutex);
+    if (gEvents.size() >= PROFILE_MAX_EVENTS) {
+        gDropped++;
+        return;
+    }
+    gEvents.push_back(e);
+}
+
+static void WriteTrace() {
+    FILE* f = fopen(PROFILE_TRACE_FILE, "w");
+    if (!f) return;
+
+    fprintf(f, "{\"traceEvents\":[\n");
+    for (size_t i = 0; i < gEvents.size(); i++) {
+        const ProfileEvent& e = gEvents[i];
+        if (e.durUs < 0) {
+            fprintf(f, "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%lld,\"pid\":1,\"tid\":%d}",
+                    e.name, (long long)e.startUs, e.tid);
+        } else {
+            fprintf(f, "{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,\"pid\":1,\"tid\":%d}",
+                    e.name, (long long)e.startUs, (long long)e.durUs, e.tid);
+        }
+        fprintf(f, i + 1 < gEvents.size() ? ",\n" : "\n");
+    }
+    fprintf(f, "]}\n");
+    fclose(f);
+}
+
+// -----------------------------
+// Public API
+// -----------------------------
+
+void ProfileInit(bool record) {
+    std::lock_guard<std::mutex> lock(gProfileMutex);
+    gRecording = record;
+    gEvents.clear();
+    gDropped = 0;
+    if (record) gEvents.reserve(256);
+}
+
+void ProfileBegin(const char* name) {
+    if (!gRecording) return;
+    tStack.push_back({ name, NowUs() });
+}
+
+void ProfileEnd() {
+    if (!gRecording || tStack.empty()) return;
+
+    OpenScope s = tStack.back();
+    tStack.pop_back();
+
+    Push({ s.name, ThreadId(), s.startUs, NowUs() - s.startUs });
+}
+
+void ProfileMark(const char* name) {
+    if (!gRecording) return;
+    Push({ name, ThreadId(), NowUs(), -1 });
+}
+
+void ProfileShutdown() {
+    std::lock_guard<std::mutex> lock(gProfileMutex);
+    if (!gRecording) return;
+
+    struct Stat {
+        int count = 0;
+        int64_t totalUs = 0;
+        int64_t maxUs = 0;
+        int64_t firstUs = 0;
+    };
+
+    // keyed by name, ordered by first start so startup reads top to bottom
+    std::map<std::string, Stat> stats;
+    std::vector<std::string> order;
+
+    for (const auto& e : gEvents) {
+        auto [it, inserted] = stats.try_emplace(e.name);
+        if (inserted) {
+            order.push_back(e.name);
+            it->second.firstUs = e.startUs;
+        }
+        if (e.durUs < 0) continue;
+
+        it->second.count++;
+        it->second.totalUs += e.durUs;
+        it->second.maxUs = std::max(it->second.maxUs, e.durUs);
+        it->second.firstUs = std::min(it->second.firstUs, e.startUs);
+    }
+
+    std::stable_sort(order.begin(), order.end(),
+        [&](const std::string& a, const std::string& b) {
+            return stats[a].firstUs < stats[b].firstUs;
+        });
+
+    printf("---- profile ----\n");
+    if (gDropped)
+        printf("(%zu events past the first %zu dropped)\n", gDropped, PROFILE_MAX_EVENTS);
+    printf("%-32s %6s %10s %10s %10s\n", "scope", "count", "total ms", "max ms", "at ms");
+    for (const auto& name : order) {
+        const Stat& s = stats[name];
+        printf("%-32s %6d %10.2f %10.2f %10.2f\n", name.c_str(), s.count,
+               s.totalUs / 1000.0, s.maxUs / 1000.0, s.firstUs / 1000.0);
+    }
+
+    FILE* f = fopen(PROFILE_SUMMARY_FILE, "w");
+    if (f) {
+        fprintf(f, "{\"scopes\":[\n");
+        for (size_t i = 0; i < order.size(); i++) {
+            const Stat& s = stats[order[i]];
+            fprintf(f, "{\"name\":\"%s\",\"count\":%d,\"total_ms\":%.3f,\"max_ms\":%.3f,\"first_ms\":%.3f}%s\n",
+                    order[i].c_str(), s.count, s.totalUs / 1000.0, s.maxUs / 1000.0,
+                    s.firstUs / 1000.0, i + 1 < order.size() ? "," : "");
+        }
+        fprintf(f, "]}\n");
+        fclose(f);
+    }
+
+    WriteTrace();
+}
+
+#endif
@@ -0,0 +1,38 @@
+#pragma once
+#include "../config.h"
+
+// Scoped timing probes for startup and level loads. On ProfileShutdown() a
+// summary is printed and written to profile_summary.json, plus a Chrome
+// trace (profile_trace.json, open in chrome://tracing or Perfetto). Only
+// when ProfileInit was told to record (--profile), otherwise every probe is
+// a bool check and nothing gets written.
+
+#if ENABLE_PROFILE
+
+void ProfileInit(bool record);   // before any other thread starts
+void ProfileShutdown();
+
+void ProfileBegin(const char* name);  // name must outlive the profiler
+void ProfileEnd();
+void ProfileMark(const char* name);   // instant event
+
+struct ProfileScope {
+    explicit ProfileScope(const char* name) { ProfileBegin(name); }
+    ~ProfileScope() { ProfileEnd(); }
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+#else
+
+inline void ProfileInit(bool) {}
+inline void ProfileShutdown() {}
+inline void ProfileBegin(const char*) {}
+inline void ProfileEnd() {}
+inline void ProfileMark(const char*) {}
+
+#define PROFILE_SCOPE(name) ((void)0)
+
+#endif
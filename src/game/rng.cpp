@@ -0,0 +1,106 @@
+#include "rng.h"
+#include <chrono>
+
+static Rng gStreams[RNG_STREAM_COUNT];
+static uint64_t gSeed = 0;
+
+// -----------------------------
+// Helpers
+// -----------------------------
+
+static inline uint64_t SplitMix(uint64_t& x) {
+    uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+static inline uint32_t Rotl(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+static inline uint32_t Step(uint32_t s[4]) {
+    uint32_t result = Rotl(s[1] * 5, 7) * 9;
+    uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = Rotl(s[3], 11);
+    return result;
+}
+
+// top 24 bits, exactly representable
+static inline float ToUnit(uint32_t x) {
+    return (x >> 8) * (1.0f / 16777216.0f);
+}
+
+// -----------------------------
+// Public API
+// -----------------------------
+
+void RngSeedAll(uint64_t seed) {
+    if (seed == 0)
+        seed = (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count() | 1u;
+    gSeed = seed;
+
+    for (int i = 0; i < RNG_STREAM_COUNT; i++)
+        RngSeed(gStreams[i], seed + 0x632be59bd9b4e019ull * (uint64_t)(i + 1));
+}
+
+uint64_t RngSeedUsed() {
+    return gSeed;
+}
+
+Rng& RngGet(RngStream stream) {
+    return gStreams[stream];
+}
+
+void RngSeed(Rng& r, uint64_t seed) {
+    uint64_t a = SplitMix(seed);
+    uint64_t b = SplitMix(seed);
+    r.s[0] = (uint32_t)a;
+    r.s[1] = (uint32_t)(a >> 32);
+    r.s[2] = (uint32_t)b;
+    r.s[3] = (uint32_t)(b >> 32);
+
+    // all zero is the one state xoshiro never leaves
+    if ((r.s[0] | r.s[1] | r.s[2] | r.s[3]) == 0) r.s[0] = 1;
+}
+
+uint32_t RngNext(Rng& r) {
+    return Step(r.s);
+}
+
+int RngInt(Rng& r, int lo, int hi) {
+    if (hi < lo) { int t = lo; lo = hi; hi = t; }
+
+    // multiply-shift, no division and no modulo bias worth caring about here
+    uint64_t span = (uint64_t)((int64_t)hi - lo) + 1;
+    return (int)((int64_t)lo + (int64_t)((Step(r.s) * span) >> 32));
+}
+
+float RngFloat(Rng& r) {
+    return ToUnit(Step(r.s));
+}
+
+float RngRange(Rng& r, float lo, float hi) {
+    return lo + (hi - lo) * ToUnit(Step(r.s));
+}
+
+void RngFill(Rng& r, uint32_t* out, int count) {
+    uint32_t s[4] = { r.s[0], r.s[1], r.s[2], r.s[3] };
+    for (int i = 0; i < count; i++)
+        out[i] = Step(s);
+    r.s[0] = s[0]; r.s[1] = s[1]; r.s[2] = s[2]; r.s[3] = s[3];
+}
+
+void RngFillRange(Rng& r, float* out, int count, float lo, float hi) {
+    uint32_t s[4] = { r.s[0], r.s[1], r.s[2], r.s[3] };
+    const float scale = (hi - lo) * (1.0f / 16777216.0f);
+    for (int i = 0; i < count; i++)
+        out[i] = lo + (Step(s) >> 8) * scale;
+    r.s[0] = s[0]; r.s[1] = s[1]; r.s[2] = s[2]; r.s[3] = s[3];
+}
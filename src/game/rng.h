@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+
+// Random numbers for everything that isn't per particle or per voice. Each
+// subsystem draws from its own xoshiro128** stream, so the menu shuffling
+// its quotes doesn't change what the UI noise does, and one seed makes a
+// whole run repeatable. Not thread safe per stream, give a thread its own.
+
+enum RngStream {
+    RNG_UI,        // hotbar noise text
+    RNG_MENU,      // floating quotes
+    RNG_AUDIO,     // audio tooling
+    RNG_STREAM_COUNT
+};
+
+struct Rng {
+    uint32_t s[4];
+};
+
+// reseeds every stream from one value, 0 picks one from the clock
+void RngSeedAll(uint64_t seed);
+uint64_t RngSeedUsed();
+
+Rng& RngGet(RngStream stream);
+void RngSeed(Rng& r, uint64_t seed);
+
+uint32_t RngNext(Rng& r);
+int RngInt(Rng& r, int lo, int hi);            // inclusive, like GetRandomValue
+float RngFloat(Rng& r);                        // [0, 1)
+float RngRange(Rng& r, float lo, float hi);
+
+// bulk versions, the state stays in registers for the whole run
+void RngFill(Rng& r, uint32_t* out, int count);
+void RngFillRange(Rng& r, float* out, int count, float lo, float hi);
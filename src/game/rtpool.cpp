@@ -0,0 +1,110 @@
+#include "rtpool.h"
+#include "../config.h"
+#include <algorithm>
+#include <vector>
+
+static std::vector<RenderTexture2D> gFree;
+
+// -----------------------------
+// Helpers
+// -----------------------------
+
+static int Bucket(int v) {
+    return std::max(1, (v + RT_POOL_BUCKET - 1) / RT_POOL_BUCKET) * RT_POOL_BUCKET;
+}
+
+static bool Fits(const RenderTexture2D& rt, int w, int h) {
+    return rt.id != 0 && rt.texture.width >= w && rt.texture.height >= h;
+}
+
+// more than 4x the pixels we need, worth trading for something smaller
+static bool Wasteful(const RenderTexture2D& rt, int w, int h) {
+    return (long)rt.texture.width * rt.texture.height > 4L * Bucket(w) * Bucket(h);
+}
+
+static void PushFree(RenderTexture2D rt) {
+    if (rt.id == 0) return;
+    gFree.push_back(rt);
+
+    if ((int)gFree.size() <= RT_POOL_FREE) return;
+
+    // drop the biggest spare, it's the one least likely to be wanted again
+    auto big = std::max_element(gFree.begin(), gFree.end(),
+        [](const RenderTexture2D& a, const RenderTexture2D& b) {
+            return a.texture.width * a.texture.height < b.texture.width * b.texture.height;
+        });
+    UnloadRenderTexture(*big);
+    gFree.erase(big);
+}
+
+static RenderTexture2D Acquire(int w, int h) {
+    // smallest spare that fits without being silly about it
+    int best = -1;
+    for (int i = 0; i < (int)gFree.size(); i++) {
+        const RenderTexture2D& rt = gFree[i];
+        if (!Fits(rt, w, h) || Wasteful(rt, w, h)) continue;
+        if (best < 0 || rt.texture.width * rt.texture.height <
+                        gFree[best].texture.width * gFree[best].texture.height)
+            best = i;
+    }
+
+    if (best >= 0) {
+        RenderTexture2D rt = gFree[best];
+        gFree.erase(gFree.begin() + best);
+        return rt;
+    }
+
+    RenderTexture2D rt = LoadRenderTexture(Bucket(w), Bucket(h));
+    SetTextureFilter(rt.texture, TEXTURE_FILTER_POINT);
+    return rt;
+}
+
+// -----------------------------
+// Public API
+// -----------------------------
+
+void RTPoolResize(PooledTarget& t, int w, int h) {
+    if (Fits(t.rt, w, h) && !Wasteful(t.rt, w, h)) {
+        t.width = w;
+        t.height = h;
+        return;
+    }
+
+    PushFree(t.rt);
+    t.rt = Acquire(w, h);
+    t.width = w;
+    t.height = h;
+}
+
+void RTPoolRelease(PooledTarget& t) {
+    PushFree(t.rt);
+    t = PooledTarget{};
+}
+
+void RTPoolShutdown() {
+    for (auto& rt : gFree)
+        UnloadRenderTexture(rt);
+    gFree.clear();
+}
+
+Rectangle RTPoolSource(const PooledTarget& t) {
+    // render textures are upside down, the drawn region sits at the top
+    // of the image so it starts texH - h rows in
+    return Rectangle{
+        0,
+        (float)(t.rt.texture.height - t.height),
+        (float)t.width,
+        -(float)t.height
+    };
+}
+
+Vector4 RTPoolRegion(const PooledTarget& t) {
+    float tw = (float)t.rt.texture.width;
+    float th = (float)t.rt.texture.height;
+    return Vector4{
+        0.0f,
+        (th - t.height) / th,
+        t.width / tw,
+        t.height / th
+    };
+}
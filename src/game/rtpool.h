@@ -0,0 +1,25 @@
+#pragma once
+#include <raylib.h>
+
+// Pool of render targets bucketed by size. A target that is bigger than
+// needed is reused through a sub-viewport (top-left width x height), so
+// shrinking the window or the internal resolution never reallocates.
+
+struct PooledTarget {
+    RenderTexture2D rt{};
+    int width = 0;    // region actually drawn to
+    int height = 0;
+};
+
+void RTPoolShutdown();
+
+// makes t cover at least w x h, reusing its texture or a pooled one if it fits
+void RTPoolResize(PooledTarget& t, int w, int h);
+void RTPoolRelease(PooledTarget& t);
+
+// source rect for DrawTexturePro, already flipped for render textures
+Rectangle RTPoolSource(const PooledTarget& t);
+
+// drawn region in texture coords as { u0, v0, du, dv }, for shaders that
+// want 0..1 over the region instead of the whole texture
+Vector4 RTPoolRegion(const PooledTarget& t);
@@ -1,11 +1,44 @@
 #include "save.h"
 #include <fstream>
-#include <unordered_set>
+#include <sstream>
+#include <map>
 #include <filesystem>
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
 
-static const char* SAVE_FILE = "save.txt";
-static std::unordered_set<std::string> remembered;
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// save.txt is a snapshot, one level per line:
+//     path [\t bestMoves \t bestTime \t deaths \t bestCoherence]
+// Plain path lines (old saves, create_god_save.py) still load fine.
+//
+// Every change is appended to save.journal in the same format, later lines
+// win. The writer thread folds the journal back into a fresh snapshot
+// (write tmp, fsync, rename) once it gets long, and on shutdown.
+
+static const char* SAVE_FILE    = "save.txt";
+static const char* JOURNAL_FILE = "save.journal";
+
+constexpr auto SAVE_COALESCE      = std::chrono::milliseconds(250);
+constexpr size_t SAVE_JOURNAL_MAX = 64;  // lines before compacting into a snapshot
+
+static std::mutex gSaveMutex;
+static std::condition_variable gSaveCv;
+
+static std::map<std::string, LevelStats> gLevels;  // every remembered level
+static std::vector<std::string> gDirty;            // lines waiting for the journal
+static size_t gJournalLines = 0;
+static bool gQuit = false;
+
+static std::thread gWriter;
 
 std::string NormalizePath(const std::string& path) {
     std::string out = path;
@@ -15,39 +48,259 @@ std::string NormalizePath(const std::string& path) {
     return out;
 }
 
+// -----------------------------
+// Format
+// -----------------------------
+
+static bool HasStats(const LevelStats& s) {
+    return s.bestMoves >= 0 || s.deaths > 0;
+}
+
+static std::string FormatLine(const std::string& path, const LevelStats& s) {
+    if (!HasStats(s)) return path;
+
+    std::ostringstream out;
+    out << path << '\t'
+        << s.bestMoves << '\t'
+        << s.bestTime << '\t'
+        << s.deaths << '\t'
+        << s.bestCoherence;
+    return out.str();
+}
+
+static void ApplyLine(const std::string& line) {
+    if (line.empty()) return;
+
+    std::stringstream ss(line);
+    std::string path;
+    std::getline(ss, path, '\t');
+    path = NormalizePath(path);
+
+    LevelStats s;
+    ss >> s.bestMoves >> s.bestTime >> s.deaths >> s.bestCoherence;
+    if (ss.fail()) s = LevelStats{};
+
+    gLevels[path] = s;
+}
+
+// A journal tail without a newline is a torn append from a crash, drop it.
+static size_t LoadFile(const char* file, bool dropTornTail) {
+    std::ifstream in(file, std::ios::binary);
+    if (!in.good()) return 0;
+
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    size_t lines = 0;
+    size_t start = 0;
+    size_t end;
+    while ((end = data.find('\n', start)) != std::string::npos) {
+        std::string line = data.substr(start, end - start);
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+
+        ApplyLine(line);
+        lines++;
+        start = end + 1;
+    }
+
+    if (!dropTornTail && start < data.size()) {
+        ApplyLine(data.substr(start));
+        lines++;
+    }
+    return lines;
+}
+
+// -----------------------------
+// Disk
+// -----------------------------
+
+static void SyncFile(FILE* f) {
+    fflush(f);
+#if defined(_WIN32)
+    _commit(_fileno(f));
+#else
+    fsync(fileno(f));
+#endif
+}
+
+static void AppendJournal(const std::vector<std::string>& lines) {
+    FILE* f = fopen(JOURNAL_FILE, "ab");
+    if (!f) return;
+
+    for (const auto& line : lines) {
+        fputs(line.c_str(), f);
+        fputc('\n', f);
+    }
+    SyncFile(f);
+    fclose(f);
+}
+
+static bool WriteSnapshot(const std::string& text) {
+    std::string tmp = std::string(SAVE_FILE) + ".tmp";
+
+    FILE* f = fopen(tmp.c_str(), "wb");
+    if (!f) return false;
+
+    bool ok = fwrite(text.data(), 1, text.size(), f) == text.size();
+    SyncFile(f);
+    ok = (fclose(f) == 0) && ok;
+    if (!ok) return false;
+
+    std::error_code ec;
+    std::filesystem::rename(tmp, SAVE_FILE, ec);
+    if (ec) return false;
+
+    // the snapshot has everything now
+    FILE* j = fopen(JOURNAL_FILE, "wb");
+    if (j) {
+        SyncFile(j);
+        fclose(j);
+    }
+    return true;
+}
+
+static std::string SerializeLocked() {
+    std::string out;
+    for (const auto& [path, stats] : gLevels) {
+        out += FormatLine(path, stats);
+        out += '\n';
+    }
+    return out;
+}
+
+static void WriterLoop() {
+    std::unique_lock<std::mutex> lock(gSaveMutex);
+
+    for (;;) {
+        gSaveCv.wait(lock, [] { return gQuit || !gDirty.empty(); });
+
+        // give bursts (restart spam, clear + next level) a moment to pile up
+        if (!gQuit)
+            gSaveCv.wait_for(lock, SAVE_COALESCE, [] { return gQuit; });
+
+        std::vector<std::string> lines;
+        lines.swap(gDirty);
+        gJournalLines += lines.size();
+
+        bool compact = gJournalLines >= SAVE_JOURNAL_MAX || (gQuit && gJournalLines > 0);
+        std::string snapshot = compact ? SerializeLocked() : std::string();
+        bool quit = gQuit;
+
+        lock.unlock();
+
+        if (!lines.empty())
+            AppendJournal(lines);
+        bool compacted = compact && WriteSnapshot(snapshot);
+
+        lock.lock();
+
+        if (compacted) gJournalLines = 0;
+        if (quit && gDirty.empty()) return;
+    }
+}
+
+// Called with gSaveMutex held.
+static void MarkDirty(const std::string& path, const LevelStats& s) {
+    gDirty.push_back(FormatLine(path, s));
+    gSaveCv.notify_one();
+}
+
+// -----------------------------
+// Public API
+// -----------------------------
+
 void SaveInit() {
-    remembered.clear();
+    std::lock_guard<std::mutex> lock(gSaveMutex);
 
-    std::ifstream in(SAVE_FILE);
-    if (!in.good()) {
+    gLevels.clear();
+    gDirty.clear();
+    gQuit = false;
+
+    if (!std::filesystem::exists(SAVE_FILE)) {
         // create empty save file
         std::ofstream out(SAVE_FILE);
-        return;
     }
 
-    std::string line;
-    while (std::getline(in, line)) {
-        if (!line.empty())
-            remembered.insert(NormalizePath(line));
+    LoadFile(SAVE_FILE, false);
+    gJournalLines = LoadFile(JOURNAL_FILE, true);
+
+    gWriter = std::thread(WriterLoop);
+}
+
+void SaveShutdown() {
+    {
+        std::lock_guard<std::mutex> lock(gSaveMutex);
+        gQuit = true;
     }
+    gSaveCv.notify_one();
+
+    if (gWriter.joinable())
+        gWriter.join();
 }
 
 bool HasRememberedLevel(const std::string& path) {
-    return remembered.contains(NormalizePath(path));
+    std::lock_guard<std::mutex> lock(gSaveMutex);
+    return gLevels.contains(NormalizePath(path));
 }
 
 void SaveRememberLevel(const std::string& path) {
     std::string norm = NormalizePath(path);
 
-    if (remembered.contains(norm))
+    std::lock_guard<std::mutex> lock(gSaveMutex);
+    if (gLevels.contains(norm))
         return;
 
-    remembered.insert(norm);
+    gLevels[norm] = LevelStats{};
+    MarkDirty(norm, gLevels[norm]);
+}
+
+void SaveRecordDeath(const std::string& path) {
+    std::string norm = NormalizePath(path);
+
+    std::lock_guard<std::mutex> lock(gSaveMutex);
+
+    // stats only for levels SaveRememberLevel already knows about
+    auto it = gLevels.find(norm);
+    if (it == gLevels.end()) return;
+
+    LevelStats& s = it->second;
+    s.deaths++;
+    MarkDirty(norm, s);
+}
+
+void SaveRecordClear(const std::string& path, int moves, float time, int coherenceLeft) {
+    std::string norm = NormalizePath(path);
+
+    std::lock_guard<std::mutex> lock(gSaveMutex);
+
+    auto it = gLevels.find(norm);
+    if (it == gLevels.end()) return;
+
+    LevelStats& s = it->second;
+
+    bool better = s.bestMoves < 0 || moves < s.bestMoves;
+    if (better) {
+        s.bestMoves = moves;
+        s.bestCoherence = coherenceLeft;
+    }
+    if (s.bestTime < 0.0f || time < s.bestTime)
+        s.bestTime = time;
+
+    MarkDirty(norm, s);
+}
+
+LevelStats SaveGetStats(const std::string& path) {
+    std::lock_guard<std::mutex> lock(gSaveMutex);
 
-    std::ofstream out(SAVE_FILE, std::ios::app);
-    out << norm << "\n";
+    auto it = gLevels.find(NormalizePath(path));
+    if (it == gLevels.end()) return LevelStats{};
+    return it->second;
 }
 
 std::vector<std::string> LoadRememberedLevels() {
-    return std::vector<std::string>(remembered.begin(), remembered.end());
+    std::lock_guard<std::mutex> lock(gSaveMutex);
+
+    std::vector<std::string> out;
+    for (const auto& [path, stats] : gLevels)
+        out.push_back(path);
+    return out;
 }
@@ -2,10 +2,25 @@
 #include <string>
 #include <vector>
 
+struct LevelStats {
+    int bestMoves = -1;      // -1 until the level has been cleared
+    float bestTime = -1.0f;  // seconds
+    int deaths = 0;
+    int bestCoherence = -1;  // mask uses left on the best clear
+};
+
+// lifecycle, SaveShutdown flushes everything still queued
 void SaveInit();
+void SaveShutdown();
+
 void SaveRememberLevel(const std::string& path);
 std::vector<std::string> LoadRememberedLevels();
 bool HasRememberedLevel(const std::string& path);
 
+// per-level stats, ignored for levels SaveRememberLevel never saw
+void SaveRecordDeath(const std::string& path);
+void SaveRecordClear(const std::string& path, int moves, float time, int coherenceLeft);
+LevelStats SaveGetStats(const std::string& path);
+
 
 std::string NormalizePath(const std::string& path);
@@ -0,0 +1,87 @@
+#include "simthread.h"
+#include <raylib.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+static std::mutex gSimMutex;
+static std::condition_variable gSimCv;
+static std::thread gWorker;
+
+static void (*gJob)(void*) = nullptr;
+static void* gArg = nullptr;
+static bool gBusy = false;
+static bool gQuit = false;
+
+// -----------------------------
+// Helpers
+// -----------------------------
+
+static void WorkerLoop() {
+    std::unique_lock<std::mutex> lock(gSimMutex);
+
+    for (;;) {
+        gSimCv.wait(lock, [] { return gQuit || gJob; });
+        if (gQuit) return;
+
+        void (*job)(void*) = gJob;
+        void* arg = gArg;
+
+        lock.unlock();
+        job(arg);
+        lock.lock();
+
+        gJob = nullptr;
+        gBusy = false;
+        gSimCv.notify_all();
+    }
+}
+
+// -----------------------------
+// Public API
+// -----------------------------
+
+void SimThreadInit(bool threaded) {
+    std::lock_guard<std::mutex> lock(gSimMutex);
+    gQuit = false;
+    gBusy = false;
+    gJob = nullptr;
+
+    TraceLog(LOG_INFO, "SIM: %s", threaded ? "pipelined on a worker thread" : "stepping inline");
+    if (threaded) gWorker = std::thread(WorkerLoop);
+}
+
+void SimThreadShutdown() {
+    SimThreadWait();
+    {
+        std::lock_guard<std::mutex> lock(gSimMutex);
+        gQuit = true;
+    }
+    gSimCv.notify_all();
+
+    if (gWorker.joinable())
+        gWorker.join();
+}
+
+bool SimThreadPipelined() {
+    return gWorker.joinable();
+}
+
+void SimThreadRun(void (*job)(void*), void* arg) {
+    // no worker, inline
+    if (!gWorker.joinable()) {
+        job(arg);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(gSimMutex);
+    gJob = job;
+    gArg = arg;
+    gBusy = true;
+    gSimCv.notify_all();
+}
+
+void SimThreadWait() {
+    std::unique_lock<std::mutex> lock(gSimMutex);
+    gSimCv.wait(lock, [] { return !gBusy; });
+}
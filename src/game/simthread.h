@@ -0,0 +1,20 @@
+#pragma once
+#include "../config.h"
+
+// One worker that runs the game simulation next to rendering. The main loop
+// waits for the previous step, copies what it needs to draw, hands the next
+// step over and renders while it runs. Started without the worker the step
+// just runs inline and nothing else changes.
+//
+// One job at a time, Run after Wait. Whatever the job touches is off limits
+// to the main thread until the next Wait returns.
+
+// threaded = false keeps everything on the calling thread
+void SimThreadInit(bool threaded);
+void SimThreadShutdown();
+
+// true while the worker is up, the main loop draws a step behind then
+bool SimThreadPipelined();
+
+void SimThreadRun(void (*job)(void*), void* arg);
+void SimThreadWait();
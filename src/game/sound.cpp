@@ -1,219 +1,111 @@
 #include "sound.h"
-#include <cmath>
+#include "synth.h"
+#include "music.h"
+#include "mixer.h"
+#include <algorithm>
 
 // -----------------------------
 // Static audio state
 // -----------------------------
 
-static Music gMainTheme;
+// mixer sample ids, movement is synthesised live (MoveParams)
+static int gDeathSound;
 
-static Sound gDeathSound;
-static Sound gStoneMoveSound;
-static Sound gWindMoveSound;
-
-static Sound gPlateSound;
-static Sound gStoneEquipSound;
-static Sound gWindEquipSound;
+static int gPlateSound;
+static int gStoneEquipSound;
+static int gWindEquipSound;
 
+// game side only, so a move stop every idle frame doesn't post anything
 static bool stonePlaying = false;
 static bool windPlaying  = false;
 
-// -----------------------------
-// Helpers
-// -----------------------------
-
-static Sound GenerateDeathSound() {
-    const int sampleRate = 22050;
-    const float duration = 0.35f;
-    const int sampleCount = (int)(sampleRate * duration);
-
-    short* samples = (short*)MemAlloc(sampleCount * sizeof(short));
-
-    float phase = 0.0f;
-    float freq = 1200.0f;
+static bool gLoopback = false;
 
-    for (int i = 0; i < sampleCount; i++) {
-        float t = (float)i / sampleCount;
+enum SoundTag {
+    TAG_STONE_MOVE = 1,
+    TAG_WIND_MOVE
+};
 
-        freq = 1200.0f - 1000.0f * t;
-        phase += (2.0f * PI * freq) / sampleRate;
+// voice stealing order, higher wins
+constexpr int PRIO_LOOP  = 1;
+constexpr int PRIO_EVENT = 2;
+constexpr int PRIO_DEATH = 3;
 
-        float square = (sinf(phase) > 0.0f) ? 1.0f : -1.0f;
-        float noise = ((float)GetRandomValue(-1000, 1000)) / 1000.0f;
-
-        float mix = square * 0.7f + noise * 0.3f;
-        float env = (t < 0.05f) ? (t / 0.05f) : (1.0f - t);
-
-        samples[i] = (short)(mix * env * 16000);
-    }
-
-    Wave wave{ (unsigned int)sampleCount, sampleRate, 16, 1, samples };
-    Sound sound = LoadSoundFromWave(wave);
+// -----------------------------
+// Helpers
+// -----------------------------
 
+// Same shapes the old per-sample loops made, see synth.h for the fields
+//                                      dur    tone         freq     end      tone  noise env              env    gain     seed
+static const SynthPatch DEATH_PATCH  = { 0.35f, TONE_SQUARE, 1200.0f, 200.0f,  0.7f, 0.3f, ENV_ATTACK_FADE, 0.05f, 16000.0f, 1 };
+// 60 cycles over the clip
+static const SynthPatch PLATE_CRUNCH = { 0.18f, TONE_SINE,   60.0f / 0.18f, 0.0f, 0.4f, 0.6f, ENV_EXP_DECAY, 8.0f, 14000.0f, 4 };
+static const SynthPatch STONE_EQUIP  = { 0.22f, TONE_SINE,   90.0f,   0.0f,    1.0f, 0.0f, ENV_EXP_DECAY,   6.0f,  16000.0f, 5 };
+static const SynthPatch WIND_EQUIP   = { 0.25f, TONE_SINE,   0.0f,    0.0f,    0.0f, 1.0f, ENV_ARCH,        0.0f,  12000.0f, 6 };
+
+static int AddSample(const SynthPatch& patch) {
+    Wave wave = SynthLoad(patch);
+    int id = MixerAddSample(wave);
     UnloadWave(wave);
-
-    return sound;
-}
-
-static Sound GenerateStoneMoveSound() {
-    const int sr = 22050;
-    const float dur = 0.25f;
-    int count = (int)(sr * dur);
-
-    short* data = (short*)MemAlloc(count * sizeof(short));
-    float phase = 0.0f;
-
-    for (int i = 0; i < count; i++) {
-        phase += 2.0f * PI * 80.0f / sr;
-        float noise = GetRandomValue(-1000, 1000) / 1000.0f;
-        float v = sinf(phase) * 0.6f + noise * 0.4f;
-        data[i] = (short)(v * 12000);
-    }
-
-    Wave w{ (unsigned int)count, sr, 16, 1, data };
-    Sound s = LoadSoundFromWave(w);
-    UnloadWave(w);
-    return s;
-}
-
-static Sound GenerateWindMoveSound() {
-    const int sr = 22050;
-    const float dur = 0.3f;
-    int count = (int)(sr * dur);
-
-    short* data = (short*)MemAlloc(count * sizeof(short));
-    float phase = 0.0f;
-
-    for (int i = 0; i < count; i++) {
-        phase += 2.0f * PI * 30.0f / sr;
-        float noise = GetRandomValue(-1000, 1000) / 1000.0f;
-        float v = noise * 0.8f + sinf(phase) * 0.2f;
-        data[i] = (short)(v * 10000);
-    }
-
-    Wave w{ (unsigned int)count, sr, 16, 1, data };
-    Sound s = LoadSoundFromWave(w);
-    UnloadWave(w);
-    return s;
-}
-
-static Sound GeneratePlateCrunchSound() {
-    const int sr = 22050;
-    const float dur = 0.18f;
-    int count = (int)(sr * dur);
-
-    short* data = (short*)MemAlloc(count * sizeof(short));
-
-    for (int i = 0; i < count; i++) {
-        float t = (float)i / count;
-        float noise = GetRandomValue(-1000, 1000) / 1000.0f;
-        float low = sinf(2.0f * PI * 60.0f * t);
-        float env = expf(-8.0f * t);
-
-        data[i] = (short)((noise * 0.6f + low * 0.4f) * env * 14000);
-    }
-
-    Wave w{ (unsigned int)count, sr, 16, 1, data };
-    Sound s = LoadSoundFromWave(w);
-    UnloadWave(w);
-    return s;
-}
-
-static Sound GenerateStoneEquipSound() {
-    const int sr = 22050;
-    const float dur = 0.22f;
-    int count = (int)(sr * dur);
-
-    short* data = (short*)MemAlloc(count * sizeof(short));
-    float phase = 0.0f;
-
-    for (int i = 0; i < count; i++) {
-        phase += 2.0f * PI * 90.0f / sr;
-        float v = sinf(phase) * expf(-6.0f * ((float)i / count));
-        data[i] = (short)(v * 16000);
-    }
-
-    Wave w{ (unsigned int)count, sr, 16, 1, data };
-    Sound s = LoadSoundFromWave(w);
-    UnloadWave(w);
-    return s;
+    return id;
 }
 
-static Sound GenerateWindEquipSound() {
-    const int sr = 22050;
-    const float dur = 0.25f;
-    int count = (int)(sr * dur);
-
-    short* data = (short*)MemAlloc(count * sizeof(short));
+// Movement voices. Faster masks pitch the rumble up, and a wind slide opens
+// up and gets louder the longer it runs. Levels match the old baked loops
+// (12000 / 10000 peak at 0.35 / 0.4 volume)
+static MixerSynthParams MoveParams(MaskType mask, int slideStep) {
+    float speed = 0.4f / MaskMoveDuration(mask);   // 1 for stone
 
-    for (int i = 0; i < count; i++) {
-        float t = (float)i / count;
-        float noise = GetRandomValue(-1000, 1000) / 1000.0f;
-        float env = sinf(PI * t);
-        data[i] = (short)(noise * env * 12000);
+    if (mask == MASK_STONE) {
+        return MixerSynthParams{
+            80.0f * speed,     // freq
+            0.6f, 0.4f,        // tone, noise
+            0.5f,              // brightness
+            0.128f,            // gain
+            0.01f, 0.06f       // attack, release
+        };
     }
 
-    Wave w{ (unsigned int)count, sr, 16, 1, data };
-    Sound s = LoadSoundFromWave(w);
-    UnloadWave(w);
-    return s;
+    float build = std::min(1.0f, slideStep / 6.0f);
+    return MixerSynthParams{
+        30.0f * speed,
+        0.2f, 0.8f,
+        0.3f + 0.6f * build,
+        0.122f * (0.75f + 0.25f * build),
+        0.02f, 0.12f
+    };
 }
 
 // -----------------------------
 // Public API
 // -----------------------------
 
-void SoundInit() {
-    InitAudioDevice();
-
-    gMainTheme = LoadMusicStream("assets/sounds/main_theme.wav");
-    gMainTheme.looping = true;
-
-    gDeathSound     = GenerateDeathSound();
-    gStoneMoveSound = GenerateStoneMoveSound();
-    gWindMoveSound  = GenerateWindMoveSound();
-
-
-    gPlateSound      = GeneratePlateCrunchSound();
-    gStoneEquipSound = GenerateStoneEquipSound();
-    gWindEquipSound  = GenerateWindEquipSound();
+void SoundInit(bool loopback) {
+    gLoopback = loopback;
+    if (!loopback) InitAudioDevice();
 
+    gDeathSound     = AddSample(DEATH_PATCH);
 
-    SetSoundVolume(gStoneMoveSound, 0.35f);
-    SetSoundVolume(gWindMoveSound, 0.4f);
+    gPlateSound      = AddSample(PLATE_CRUNCH);
+    gStoneEquipSound = AddSample(STONE_EQUIP);
+    gWindEquipSound  = AddSample(WIND_EQUIP);
 
-    SetSoundVolume(gPlateSound, 0.6f);
-    SetSoundVolume(gStoneEquipSound, 0.7f);
-    SetSoundVolume(gWindEquipSound, 0.6f);
-
-    PlayMusicStream(gMainTheme);
+    MixerStart(loopback);
+    if (!loopback) MusicInit();
 }
 
 void SoundShutdown() {
-    UnloadSound(gDeathSound);
-    UnloadSound(gStoneMoveSound);
-    UnloadSound(gWindMoveSound);
-    UnloadMusicStream(gMainTheme);
-    CloseAudioDevice();
-}
-
-void SoundUpdate() {
-    UpdateMusicStream(gMainTheme);
-    if (stonePlaying && !IsSoundPlaying(gStoneMoveSound)) {
-        PlaySound(gStoneMoveSound);
-    }
-
-    if (windPlaying && !IsSoundPlaying(gWindMoveSound)) {
-        PlaySound(gWindMoveSound);
-    }
+    MusicShutdown();
+    MixerShutdown();
+    if (!gLoopback) CloseAudioDevice();
 }
 
 void SoundPlayMusic() {
-    ResumeMusicStream(gMainTheme);
+    MusicPlay();
 }
 
 void SoundPauseMusic() {
-    PauseMusicStream(gMainTheme);
+    MusicPause();
 }
 
 // -----------------------------
@@ -221,56 +113,54 @@ void SoundPauseMusic() {
 // -----------------------------
 
 void SoundOnDeath() {
-    StopSound(gStoneMoveSound);
-    StopSound(gWindMoveSound);
-    stonePlaying = windPlaying = false;
+    SoundStopMovement();
 
-    StopMusicStream(gMainTheme);
-    PlaySound(gDeathSound);
+    MusicStop();
+    MixerPlay(gDeathSound, 1.0f, PRIO_DEATH);
 }
 
-void SoundOnMoveStart(MaskType mask) {
+void SoundOnMoveStart(MaskType mask, int slideStep) {
     if (mask == MASK_STONE && !stonePlaying) {
-        PlaySound(gStoneMoveSound);
+        MixerSynthGate(TAG_STONE_MOVE, MoveParams(mask, 0), PRIO_LOOP);
         stonePlaying = true;
     }
-    if (mask == MASK_WIND && !windPlaying) {
-        PlaySound(gWindMoveSound);
+    // every step of a slide retunes the same voice
+    if (mask == MASK_WIND) {
+        MixerSynthGate(TAG_WIND_MOVE, MoveParams(mask, slideStep), PRIO_LOOP);
         windPlaying = true;
     }
 }
 
 void SoundOnMoveStop(MaskType mask) {
     if (mask == MASK_STONE && stonePlaying) {
-        StopSound(gStoneMoveSound);
+        MixerSynthRelease(TAG_STONE_MOVE);
         stonePlaying = false;
     }
     if (mask == MASK_WIND && windPlaying) {
-        StopSound(gWindMoveSound);
+        MixerSynthRelease(TAG_WIND_MOVE);
         windPlaying = false;
     }
 }
 
 void SoundOnPlate() {
-    PlaySound(gPlateSound);
+    MixerPlay(gPlateSound, 0.6f, PRIO_EVENT);
 }
 
 void SoundOnMaskSwitch(MaskType mask) {
     if (mask == MASK_STONE) {
-        PlaySound(gStoneEquipSound);
+        MixerPlay(gStoneEquipSound, 0.7f, PRIO_EVENT);
     } else if (mask == MASK_WIND) {
-        PlaySound(gWindEquipSound);
+        MixerPlay(gWindEquipSound, 0.6f, PRIO_EVENT);
     }
 }
 
 void SoundStopMovement() {
-    StopSound(gStoneMoveSound);
-    StopSound(gWindMoveSound);
+    MixerStopTag(TAG_STONE_MOVE);
+    MixerStopTag(TAG_WIND_MOVE);
     stonePlaying = false;
     windPlaying  = false;
 }
 
 void SoundRestartMusic() {
-    StopMusicStream(gMainTheme);
-    PlayMusicStream(gMainTheme);
+    MusicRestart();
 }
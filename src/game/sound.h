@@ -2,18 +2,17 @@
 #include <raylib.h>
 #include "mask.h"
 
-// lifecycle
-void SoundInit();
+// lifecycle, loopback = no device and no music (see audiotest.h)
+void SoundInit(bool loopback = false);
 void SoundShutdown();
 
 // music
 void SoundPlayMusic();
 void SoundPauseMusic();
-void SoundUpdate();
 
 // events
 void SoundOnDeath();
-void SoundOnMoveStart(MaskType mask);
+void SoundOnMoveStart(MaskType mask, int slideStep);   // slideStep 0 = first step
 void SoundOnMoveStop(MaskType mask);
 void SoundOnPlate();
 void SoundOnMaskSwitch(MaskType mask);
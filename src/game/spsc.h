@@ -0,0 +1,39 @@
+#pragma once
+#include <atomic>
+
+// Fixed size single producer / single consumer queue, no locks. One thread
+// only pushes, one thread only pops. N must be a power of two.
+
+template <typename T, unsigned N>
+struct SpscQueue {
+    static_assert((N & (N - 1)) == 0, "SpscQueue size must be a power of two");
+
+    T items[N];
+    std::atomic<unsigned> head{0};   // next write, producer
+    std::atomic<unsigned> tail{0};   // next read, consumer
+
+    // false when full, the item is dropped
+    bool Push(const T& item) {
+        unsigned h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= N) return false;
+
+        items[h % N] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Pop(T& out) {
+        unsigned t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) return false;
+
+        out = items[t % N];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // only while neither side is running
+    void Reset() {
+        head.store(0);
+        tail.store(0);
+    }
+};
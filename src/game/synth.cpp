@@ -0,0 +1,233 @@
+#include "synth.h"
+#include "../config.h"
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static const char* SYNTH_DIR = "cache/sfx";
+
+constexpr int LANES = 8;                  // independent generators per kernel
+constexpr uint32_t SYNTH_VERSION = 1;     // bump when the kernels change output
+constexpr uint32_t SFX_MAGIC = 0x31584653; // "SFX1"
+
+// -----------------------------
+// Kernels
+// -----------------------------
+// All of these work on buffers padded to a multiple of LANES, lane l handles
+// samples l, l + LANES, ... so the inner loops have no cross-lane dependency.
+
+static void KernelNoise(float* out, int n, uint32_t seed, float amp) {
+    uint32_t s[LANES];
+    for (int l = 0; l < LANES; l++) {
+        // spread the seed so neighbouring lanes don't start correlated
+        uint32_t z = seed + 0x9e3779b9u * (uint32_t)(l + 1);
+        z = (z ^ (z >> 16)) * 0x85ebca6bu;
+        z = (z ^ (z >> 13)) * 0xc2b2ae35u;
+        s[l] = (z ^ (z >> 16)) | 1u;
+    }
+
+    const float scale = amp / 2147483648.0f;
+    for (int i = 0; i < n; i += LANES) {
+        for (int l = 0; l < LANES; l++) {
+            uint32_t x = s[l];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            s[l] = x;
+            out[i + l] += (float)(int32_t)x * scale;
+        }
+    }
+}
+
+// sin(step * i) as LANES rotating phasors, each advances LANES steps a block
+static void KernelSine(float* out, int n, float step, float amp) {
+    float re[LANES], im[LANES];
+    for (int l = 0; l < LANES; l++) {
+        re[l] = cosf(step * l);
+        im[l] = sinf(step * l);
+    }
+    const float cr = cosf(step * LANES);
+    const float ci = sinf(step * LANES);
+
+    for (int i = 0; i < n; i += LANES) {
+        for (int l = 0; l < LANES; l++) {
+            out[i + l] += im[l] * amp;
+
+            float r = re[l] * cr - im[l] * ci;
+            float m = re[l] * ci + im[l] * cr;
+
+            // one Newton step back onto the unit circle, stops the drift
+            float g = 1.5f - 0.5f * (r * r + m * m);
+            re[l] = r * g;
+            im[l] = m * g;
+        }
+    }
+}
+
+// square wave sweeping f0 -> f1 over count samples, phase is closed form
+static void KernelSquareSweep(float* out, int n, int count, float f0, float f1, float amp) {
+    const float a = f0 / SYNTH_SAMPLE_RATE;
+    const float b = (f1 - f0) / (2.0f * count * SYNTH_SAMPLE_RATE);
+
+    for (int i = 0; i < n; i++) {
+        float x = (float)i;
+        float cycles = x * (a + b * x);
+        float frac = cycles - floorf(cycles);
+        out[i] += frac < 0.5f ? amp : -amp;
+    }
+}
+
+// exp(-k * i / count) as LANES decaying lanes
+static void KernelExpDecay(float* out, int n, int count, float k) {
+    float e[LANES];
+    for (int l = 0; l < LANES; l++)
+        e[l] = expf(-k * l / count);
+    const float r = expf(-k * LANES / count);
+
+    for (int i = 0; i < n; i += LANES) {
+        for (int l = 0; l < LANES; l++) {
+            out[i + l] *= e[l];
+            e[l] *= r;
+        }
+    }
+}
+
+static void KernelAttackFade(float* out, int n, int count, float attack) {
+    const float inv = 1.0f / count;
+    for (int i = 0; i < n; i++) {
+        float t = i * inv;
+        out[i] *= t < attack ? t / attack : 1.0f - t;
+    }
+}
+
+static void KernelToPcm(const float* in, short* out, int count, float gain) {
+    for (int i = 0; i < count; i++) {
+        float v = in[i] * gain;
+        v = v > 32767.0f ? 32767.0f : v < -32768.0f ? -32768.0f : v;
+        out[i] = (short)v;
+    }
+}
+
+// -----------------------------
+// Helpers
+// -----------------------------
+
+static std::string CacheFile(const SynthPatch& patch) {
+    // FNV-1a over the patch (all 4 byte fields, no padding) and the version
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&](const void* data, size_t len) {
+        const unsigned char* p = (const unsigned char*)data;
+        for (size_t i = 0; i < len; i++) {
+            h ^= p[i];
+            h *= 1099511628211ull;
+        }
+    };
+    mix(&patch, sizeof(patch));
+    mix(&SYNTH_VERSION, sizeof(SYNTH_VERSION));
+    mix(&SYNTH_SAMPLE_RATE, sizeof(SYNTH_SAMPLE_RATE));
+
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%s/%016llx.pcm", SYNTH_DIR, (unsigned long long)h);
+    return buf;
+}
+
+static bool ReadCached(const std::string& path, Wave& wave) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+
+    uint32_t header[2] = {};
+    bool ok = fread(header, sizeof(header), 1, f) == 1 &&
+              header[0] == SFX_MAGIC && header[1] > 0 && header[1] < (1u << 24);
+
+    if (ok) {
+        short* data = (short*)MemAlloc(header[1] * sizeof(short));
+        ok = fread(data, sizeof(short), header[1], f) == header[1];
+
+        if (ok) wave = Wave{ header[1], (unsigned int)SYNTH_SAMPLE_RATE, 16, 1, data };
+        else    MemFree(data);
+    }
+
+    fclose(f);
+    return ok;
+}
+
+static void WriteCached(const std::string& path, const Wave& wave) {
+    std::error_code ec;
+    fs::create_directories(SYNTH_DIR, ec);
+
+    // tmp + rename so a killed process never leaves half a file behind
+    std::string tmp = path + ".tmp";
+    FILE* f = fopen(tmp.c_str(), "wb");
+    if (!f) return;
+
+    uint32_t header[2] = { SFX_MAGIC, wave.frameCount };
+    bool ok = fwrite(header, sizeof(header), 1, f) == 1 &&
+              fwrite(wave.data, sizeof(short), wave.frameCount, f) == wave.frameCount;
+    fclose(f);
+
+    if (ok) fs::rename(tmp, path, ec);
+    else    fs::remove(tmp, ec);
+}
+
+// -----------------------------
+// Public API
+// -----------------------------
+
+Wave SynthRender(const SynthPatch& patch) {
+    const int count = (int)(SYNTH_SAMPLE_RATE * patch.duration);
+    const int n = (count + LANES - 1) / LANES * LANES;
+
+    static std::vector<float> mix, env;
+    mix.assign(n, 0.0f);
+
+    if (patch.toneMix > 0.0f) {
+        if (patch.tone == TONE_SQUARE)
+            KernelSquareSweep(mix.data(), n, count, patch.freq, patch.freqEnd, patch.toneMix);
+        else
+            KernelSine(mix.data(), n, 2.0f * PI * patch.freq / SYNTH_SAMPLE_RATE, patch.toneMix);
+    }
+
+    if (patch.noiseMix > 0.0f)
+        KernelNoise(mix.data(), n, patch.seed, patch.noiseMix);
+
+    switch (patch.env) {
+        case ENV_ATTACK_FADE:
+            KernelAttackFade(mix.data(), n, count, patch.envParam);
+            break;
+
+        case ENV_EXP_DECAY:
+            KernelExpDecay(mix.data(), n, count, patch.envParam);
+            break;
+
+        case ENV_ARCH:
+            env.assign(n, 0.0f);
+            KernelSine(env.data(), n, PI / count, 1.0f);
+            for (int i = 0; i < n; i++) mix[i] *= env[i];
+            break;
+
+        case ENV_NONE:
+            break;
+    }
+
+    short* data = (short*)MemAlloc(count * sizeof(short));
+    KernelToPcm(mix.data(), data, count, patch.gain);
+
+    return Wave{ (unsigned int)count, (unsigned int)SYNTH_SAMPLE_RATE, 16, 1, data };
+}
+
+Wave SynthLoad(const SynthPatch& patch) {
+#if SYNTH_DISK_CACHE
+    Wave wave{};
+    std::string path = CacheFile(patch);
+    if (!ReadCached(path, wave)) {
+        wave = SynthRender(patch);
+        WriteCached(path, wave);
+    }
+    return wave;
+#else
+    return SynthRender(patch);
+#endif
+}
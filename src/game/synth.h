@@ -0,0 +1,44 @@
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+
+// Offline synthesis for the little procedural sound effects. A patch is a
+// tone (sine or swept square) plus white noise, times an envelope. The
+// kernels run over float blocks in independent lanes, which gcc vectorises
+// with the makefile's OPT flags: xorshift noise, phasor sines and a
+// recurrence for the exponential decay, no sinf/expf/GetRandomValue per
+// sample.
+//
+// Results are cached as raw PCM in cache/sfx/, keyed by the patch, so a
+// warm start just reads the files back.
+
+enum SynthEnvelope {
+    ENV_NONE,
+    ENV_ATTACK_FADE,   // linear up over envParam (0..1 of the clip), then down to 0
+    ENV_EXP_DECAY,     // exp(-envParam * t)
+    ENV_ARCH           // sin(pi * t)
+};
+
+enum SynthTone {
+    TONE_SINE,         // fixed freq
+    TONE_SQUARE        // freq -> freqEnd, linear over the clip
+};
+
+struct SynthPatch {
+    float duration;     // seconds
+    SynthTone tone;
+    float freq;         // Hz
+    float freqEnd;      // Hz, square only
+    float toneMix;
+    float noiseMix;
+    SynthEnvelope env;
+    float envParam;
+    float gain;         // int16 peak
+    uint32_t seed;      // noise, same seed = same samples
+};
+
+// 16 bit mono at SYNTH_SAMPLE_RATE, caller owns it (UnloadWave)
+Wave SynthRender(const SynthPatch& patch);
+
+// SynthRender through the disk cache, same ownership
+Wave SynthLoad(const SynthPatch& patch);
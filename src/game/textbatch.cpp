@@ -0,0 +1,132 @@
+#include "textbatch.h"
+#include <rlgl.h>
+#include <cmath>
+#include <vector>
+
+constexpr int TEXT_LINE_SPACING = 2;    // raylib's default, keeps \n layout identical
+constexpr int TEXT_FLUSH_QUADS  = 1024; // stay well inside rlgl's batch buffer
+
+struct GlyphQuad {
+    Vector2 pos[4];   // tl, bl, br, tr like raylib's DrawTexturePro
+    Vector2 uv[4];
+    Color color;
+};
+
+static std::vector<GlyphQuad> gQuads;
+
+// -----------------------------
+// Helpers
+// -----------------------------
+
+static Vector2 Transform(Vector2 p, Vector2 position, Vector2 origin, float s, float c) {
+    float x = p.x - origin.x;
+    float y = p.y - origin.y;
+    return Vector2{ position.x + x * c - y * s, position.y + x * s + y * c };
+}
+
+// -----------------------------
+// Public API
+// -----------------------------
+
+void TextBatchBegin() {
+    gQuads.clear();
+}
+
+void TextBatchDraw(const char* text, int x, int y, int fontSize, Color color) {
+    const int defaultSize = 10;
+    if (fontSize < defaultSize) fontSize = defaultSize;
+    int spacing = fontSize / defaultSize;
+
+    TextBatchDrawPro(text, Vector2{ (float)x, (float)y }, Vector2{ 0, 0 },
+                     0.0f, (float)fontSize, (float)spacing, color);
+}
+
+void TextBatchDrawPro(const char* text, Vector2 position, Vector2 origin,
+                      float rotation, float fontSize, float spacing, Color color) {
+    if (!text || !*text) return;
+
+    Font font = GetFontDefault();
+    float scale = fontSize / font.baseSize;
+    float pad = (float)font.glyphPadding;
+    float tw = (float)font.texture.width;
+    float th = (float)font.texture.height;
+
+    float rad = rotation * DEG2RAD;
+    float s = sinf(rad);
+    float c = cosf(rad);
+
+    float offsetX = 0.0f;
+    float offsetY = 0.0f;
+
+    for (const char* p = text; *p; ) {
+        int size = 0;
+        int codepoint = GetCodepointNext(p, &size);
+        p += size;
+
+        int index = GetGlyphIndex(font, codepoint);
+        const Rectangle& rec = font.recs[index];
+        const GlyphInfo& glyph = font.glyphs[index];
+
+        if (codepoint == '\n') {
+            offsetX = 0.0f;
+            offsetY += fontSize + TEXT_LINE_SPACING;
+            continue;
+        }
+
+        if (codepoint != ' ' && codepoint != '\t') {
+            float x0 = offsetX + glyph.offsetX * scale - pad * scale;
+            float y0 = offsetY + glyph.offsetY * scale - pad * scale;
+            float x1 = x0 + (rec.width + 2.0f * pad) * scale;
+            float y1 = y0 + (rec.height + 2.0f * pad) * scale;
+
+            float u0 = (rec.x - pad) / tw;
+            float v0 = (rec.y - pad) / th;
+            float u1 = (rec.x + rec.width + pad) / tw;
+            float v1 = (rec.y + rec.height + pad) / th;
+
+            GlyphQuad q;
+            q.pos[0] = Transform(Vector2{ x0, y0 }, position, origin, s, c);
+            q.pos[1] = Transform(Vector2{ x0, y1 }, position, origin, s, c);
+            q.pos[2] = Transform(Vector2{ x1, y1 }, position, origin, s, c);
+            q.pos[3] = Transform(Vector2{ x1, y0 }, position, origin, s, c);
+            q.uv[0] = Vector2{ u0, v0 };
+            q.uv[1] = Vector2{ u0, v1 };
+            q.uv[2] = Vector2{ u1, v1 };
+            q.uv[3] = Vector2{ u1, v0 };
+            q.color = color;
+            gQuads.push_back(q);
+        }
+
+        offsetX += (glyph.advanceX == 0 ? rec.width : (float)glyph.advanceX) * scale + spacing;
+    }
+}
+
+void TextBatchFlush() {
+    if (gQuads.empty()) return;
+
+    Font font = GetFontDefault();
+    rlSetTexture(font.texture.id);
+
+    for (size_t first = 0; first < gQuads.size(); first += TEXT_FLUSH_QUADS) {
+        size_t last = first + TEXT_FLUSH_QUADS;
+        if (last > gQuads.size()) last = gQuads.size();
+
+        // flushes first if the current batch can't take the whole chunk
+        rlCheckRenderBatchLimit((int)(last - first) * 4);
+
+        rlBegin(RL_QUADS);
+        for (size_t i = first; i < last; i++) {
+            const GlyphQuad& q = gQuads[i];
+            rlColor4ub(q.color.r, q.color.g, q.color.b, q.color.a);
+            rlNormal3f(0.0f, 0.0f, 1.0f);
+            for (int v = 0; v < 4; v++) {
+                rlTexCoord2f(q.uv[v].x, q.uv[v].y);
+                rlVertex2f(q.pos[v].x, q.pos[v].y);
+            }
+        }
+        rlEnd();
+    }
+
+    rlSetTexture(0);
+    gQuads.clear();
+}
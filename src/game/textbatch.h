@@ -0,0 +1,21 @@
+#pragma once
+#include <raylib.h>
+
+// Text on the default font, batched. Glyph quads are built on the CPU (with
+// rotation baked in) and submitted in one rlBegin(RL_QUADS) against the font
+// atlas, so a screen full of noise or quotes is one draw call no matter what
+// gets drawn around it.
+//
+//   TextBatchBegin();
+//   TextBatchDraw(...); TextBatchDrawPro(...);
+//   TextBatchFlush();
+
+void TextBatchBegin();
+void TextBatchFlush();
+
+// same layout as DrawText (min size 10, spacing size/10)
+void TextBatchDraw(const char* text, int x, int y, int fontSize, Color color);
+
+// same layout as DrawTextPro with the default font
+void TextBatchDrawPro(const char* text, Vector2 position, Vector2 origin,
+                      float rotation, float fontSize, float spacing, Color color);
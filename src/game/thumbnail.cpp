@@ -0,0 +1,281 @@
+#include "thumbnail.h"
+#include "catalogue.h"
+#include "level.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+static const char* THUMB_DIR = "cache/thumbs";
+
+constexpr int THUMB_TILE_PX       = 4;    // pixels per tile in the minimap
+constexpr size_t THUMB_CACHE_SIZE = 128;  // textures kept alive
+constexpr size_t THUMB_QUEUE_MAX  = 64;   // pending requests before dropping old ones
+constexpr int THUMB_UPLOADS_PER_FRAME = 4;
+
+struct ThumbRequest {
+    std::string key;
+    std::string path;
+};
+
+struct ThumbResult {
+    std::string key;
+    Image image;
+};
+
+struct ThumbSlot {
+    Texture2D texture;
+    std::list<std::string>::iterator lru;
+};
+
+// worker side
+static std::thread gWorker;
+static std::mutex gQueueMutex;
+static std::condition_variable gQueueCv;
+static std::deque<ThumbRequest> gRequests;
+static std::vector<ThumbResult> gResults;
+static std::unordered_set<std::string> gLiveKeys;   // prune against these
+static bool gPrune = false;
+static bool gQuit = false;
+
+// main thread only
+static std::unordered_map<std::string, ThumbSlot> gSlots;
+static std::list<std::string> gLru;               // front = most recently used
+static std::unordered_set<std::string> gPending;  // requested, not uploaded yet
+static unsigned int gPrunedGeneration = 0;
+
+// -----------------------------
+// Helpers
+// -----------------------------
+
+static std::string ThumbKey(const std::string& path, int64_t mtime) {
+    // FNV-1a over path + mtime, doubles as the cache file name
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&](const void* data, size_t len) {
+        const unsigned char* p = (const unsigned char*)data;
+        for (size_t i = 0; i < len; i++) {
+            h ^= p[i];
+            h *= 1099511628211ull;
+        }
+    };
+    mix(path.data(), path.size());
+    mix(&mtime, sizeof(mtime));
+
+    char buf[17];
+    snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)h);
+    return buf;
+}
+
+static std::string ThumbFile(const std::string& key) {
+    return std::string(THUMB_DIR) + "/" + key + ".png";
+}
+
+static Color TileColor(Tile t) {
+    switch (t) {
+        case TILE_WALL:               return Color{ 90, 90, 90, 255 };
+        case TILE_EMPTY:              return Color{ 30, 30, 30, 255 };
+        case TILE_FLAME:              return Color{ 230, 110, 20, 255 };
+        case TILE_PIT:                return BLACK;
+        case TILE_GOAL:               return Color{ 240, 220, 60, 255 };
+        case TILE_GLASS:              return Color{ 120, 180, 220, 255 };
+        case TILE_PRESSUREPLATE:      return Color{ 150, 130, 90, 255 };
+        case TILE_PRESSUREPLATE_USED: return Color{ 90, 80, 60, 255 };
+        case TILE_DOOR_CLOSED:        return Color{ 120, 70, 40, 255 };
+        case TILE_DOOR_OPEN:          return Color{ 60, 40, 25, 255 };
+        default:                      return DARKGRAY;
+    }
+}
+
+static Image RenderThumbnail(const Level& level) {
+    const World& w = level.world;
+    int iw = w.width * THUMB_TILE_PX;
+    int ih = w.height * THUMB_TILE_PX;
+
+    Image img = GenImageColor(iw, ih, BLACK);
+    Color* px = (Color*)img.data;
+
+    for (int y = 0; y < w.height; y++) {
+        for (int x = 0; x < w.width; x++) {
+            Color c = TileColor(w.Get(x, y));
+            if (x == level.spawnX && y == level.spawnY) c = RED;
+
+            for (int py = 0; py < THUMB_TILE_PX; py++) {
+                Color* row = px + (y * THUMB_TILE_PX + py) * iw + x * THUMB_TILE_PX;
+                for (int pxx = 0; pxx < THUMB_TILE_PX; pxx++) row[pxx] = c;
+            }
+        }
+    }
+    return img;
+}
+
+// every edit leaves the old path+mtime png behind, drop whatever no
+// catalogue entry maps to anymore. Worker only, it's the one writing them
+static void PruneCache(const std::unordered_set<std::string>& live) {
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(THUMB_DIR, ec)) {
+        if (entry.path().extension() != ".png") continue;
+        if (live.contains(entry.path().stem().string())) continue;
+        std::filesystem::remove(entry.path(), ec);
+    }
+}
+
+static void WorkerLoop() {
+    for (;;) {
+        ThumbRequest req;
+        {
+            std::unique_lock<std::mutex> lock(gQueueMutex);
+            gQueueCv.wait(lock, [] { return gQuit || gPrune || !gRequests.empty(); });
+            if (gQuit) return;
+
+            if (gPrune) {
+                std::unordered_set<std::string> live;
+                live.swap(gLiveKeys);
+                gPrune = false;
+
+                lock.unlock();
+                PruneCache(live);
+                continue;
+            }
+
+            // newest first, whatever was asked for last is what's on screen
+            req = std::move(gRequests.back());
+            gRequests.pop_back();
+        }
+
+        std::string file = ThumbFile(req.key);
+        Image img{};
+
+        if (FileExists(file.c_str())) {
+            img = LoadImage(file.c_str());
+        }
+
+        if (img.data == nullptr) {
+            Level level{};
+            if (level.Parse(req.path)) {
+                img = RenderThumbnail(level);
+                ExportImage(img, file.c_str());
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(gQueueMutex);
+        gResults.push_back({ req.key, img });
+    }
+}
+
+// -----------------------------
+// Public API
+// -----------------------------
+
+void ThumbnailInit() {
+    std::error_code ec;
+    std::filesystem::create_directories(THUMB_DIR, ec);
+
+    gQuit = false;
+    gWorker = std::thread(WorkerLoop);
+}
+
+void ThumbnailShutdown() {
+    {
+        std::lock_guard<std::mutex> lock(gQueueMutex);
+        gQuit = true;
+        gRequests.clear();
+    }
+    gQueueCv.notify_all();
+
+    if (gWorker.joinable())
+        gWorker.join();
+
+    for (auto& r : gResults)
+        if (r.image.data) UnloadImage(r.image);
+    gResults.clear();
+
+    for (auto& [key, slot] : gSlots)
+        UnloadTexture(slot.texture);
+    gSlots.clear();
+    gLru.clear();
+    gPending.clear();
+}
+
+void ThumbnailUpdate() {
+    // a finished catalogue scan says which thumbnails can still be asked for
+    unsigned int generation = CatalogueGeneration();
+    if (generation != gPrunedGeneration) {
+        gPrunedGeneration = generation;
+
+        std::unordered_set<std::string> live;
+        for (const auto& e : CatalogueSnapshot())
+            live.insert(ThumbKey(e.path, e.mtime));
+
+        // no index yet, don't take the whole cache with it
+        if (!live.empty()) {
+            std::lock_guard<std::mutex> lock(gQueueMutex);
+            gLiveKeys.swap(live);
+            gPrune = true;
+            gQueueCv.notify_one();
+        }
+    }
+
+    std::vector<ThumbResult> done;
+    {
+        std::lock_guard<std::mutex> lock(gQueueMutex);
+        int n = std::min((int)gResults.size(), THUMB_UPLOADS_PER_FRAME);
+        done.assign(gResults.begin(), gResults.begin() + n);
+        gResults.erase(gResults.begin(), gResults.begin() + n);
+    }
+
+    for (auto& r : done) {
+        // broken levels stay pending so they aren't reparsed every frame
+        if (r.image.data == nullptr) continue;
+        gPending.erase(r.key);
+
+        ThumbSlot slot;
+        slot.texture = LoadTextureFromImage(r.image);
+        SetTextureFilter(slot.texture, TEXTURE_FILTER_POINT);
+        UnloadImage(r.image);
+
+        gLru.push_front(r.key);
+        slot.lru = gLru.begin();
+        gSlots[r.key] = slot;
+    }
+
+    while (gSlots.size() > THUMB_CACHE_SIZE) {
+        auto it = gSlots.find(gLru.back());
+        UnloadTexture(it->second.texture);
+        gSlots.erase(it);
+        gLru.pop_back();
+    }
+}
+
+const Texture2D* ThumbnailGet(const std::string& path, int64_t mtime) {
+    std::string key = ThumbKey(path, mtime);
+
+    auto it = gSlots.find(key);
+    if (it != gSlots.end()) {
+        gLru.splice(gLru.begin(), gLru, it->second.lru);
+        return &it->second.texture;
+    }
+
+    if (gPending.contains(key)) return nullptr;
+    gPending.insert(key);
+
+    {
+        std::lock_guard<std::mutex> lock(gQueueMutex);
+        gRequests.push_back({ key, path });
+
+        // scrolled past these, not worth rendering anymore
+        while (gRequests.size() > THUMB_QUEUE_MAX) {
+            gPending.erase(gRequests.front().key);
+            gRequests.pop_front();
+        }
+    }
+    gQueueCv.notify_one();
+
+    return nullptr;
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <raylib.h>
+#include <string>
+#include <cstdint>
+
+// Minimap thumbnails for LEVEL SELECT. Levels are rasterised on a worker
+// thread (or read back from cache/thumbs/), uploaded on the main thread in
+// ThumbnailUpdate() and kept in a small LRU of textures. Cached files that
+// no catalogue entry maps to anymore are deleted after each scan.
+
+void ThumbnailInit();
+void ThumbnailShutdown();
+
+// main thread, once per frame: uploads finished images, evicts old textures,
+// prunes cache/thumbs/ when the catalogue changed
+void ThumbnailUpdate();
+
+// returns nullptr until the thumbnail is ready, queues it if needed
+const Texture2D* ThumbnailGet(const std::string& path, int64_t mtime);
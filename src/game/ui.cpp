@@ -1,46 +1,41 @@
 #include "ui.h"
+#include "textbatch.h"
+#include "anim.h"
+#include "particles.h"
+#include "rng.h"
+#include "rtpool.h"
 #include <fstream>
 #include <cmath>
 
-constexpr int SPRITE_SIZE  = 32;
-constexpr int SHEET_COLS   = 8;
-constexpr int TOTAL_FRAMES = 64;
-constexpr float MASK_FPS   = 12.0f;
-
 void HotbarInit(Hotbar* hb) {
     hb->selected = -1;
     hb->animTimer = 0.0f;
 
-    hb->slots[0] = {
-        MASK_STONE,
-        LoadTexture("assets/mask_sprites/stone_mask_sprite.png")
-    };
-    SetTextureFilter(hb->slots[0].texture, TEXTURE_FILTER_POINT);
-    hb->slots[1] = {
-        MASK_WIND, 
-        LoadTexture("assets/mask_sprites/wind_mask_sprite.png")
-    };
-    SetTextureFilter(hb->slots[1].texture, TEXTURE_FILTER_POINT);
+    // the sheets are owned by the anim registry, this runs on every level load
+    hb->slots[0] = { MASK_STONE, AnimFind("mask_stone") };
+    hb->slots[1] = { MASK_WIND,  AnimFind("mask_wind") };
 
     for (int i = 2; i < HOTBAR_SLOTS; i++) {
-        hb->slots[i] = { MASK_NONE, {} };
+        hb->slots[i] = { MASK_NONE, ANIM_NONE };
     }
 }
 
-void HotbarUpdate(Hotbar* hb, float dt, int* maskUses, bool playerMoving) {
+int HotbarPressedSlot() {
+    if (IsKeyPressed(KEY_TWO)) return 1;
+    if (IsKeyPressed(KEY_ONE)) return 0;
+    return -1;
+}
+
+void HotbarUpdate(Hotbar* hb, float dt, int* maskUses, bool playerMoving, int pressedSlot) {
     hb->animTimer += dt;
 
     if (playerMoving) return;
 
     int change = 0;
 
-    if (IsKeyPressed(KEY_ONE))   {
-        if (hb->selected != 0) change = 1;
-        hb->selected = 0; 
-    }
-    if (IsKeyPressed(KEY_TWO))   {
-        if (hb->selected != 1) change = 1;
-        hb->selected = 1; 
+    if (pressedSlot >= 0) {
+        if (hb->selected != pressedSlot) change = 1;
+        hb->selected = pressedSlot;
     }
     if (change) {
         *maskUses -= 1; 
@@ -53,105 +48,155 @@ MaskType HotbarGetSelectedMask(const Hotbar* hb) {
     return hb->slots[hb->selected].mask;
 }
 
-void HotbarDraw(const Hotbar* hb, int maskUses) {
-    int screenW = GetScreenWidth();
-    int screenH = GetScreenHeight();
+// ------------------------------------------------------------
+// The strip only changes with the uses left, the selection or the size, so
+// it lives in its own target. Per frame it's that quad plus the selected
+// mask's animation and the COHERENCE label on top.
+// ------------------------------------------------------------
+
+struct HotbarLayout {
+    int barY;
+    int slotSize;
+    int padding;
+    int startX;
+    int slotY;
+    int label;      // COHERENCE font size, drawn live just above the strip
+
+    int SlotX(int i) const { return startX + i * (slotSize + padding); }
+};
 
-    int barY = screenH - UI_HEIGHT;
-    DrawRectangle(0, barY, screenW, UI_HEIGHT, BLACK);
+struct HudCache {
+    PooledTarget target;
+    int selected = -2;
+    int screenW = 0;
+    int screenH = 0;
+    int uiHeight = 0;
+};
 
-    int slotSize = UI_HEIGHT * 0.8;
-    int padding = 12;
-    int totalW = HOTBAR_SLOTS * slotSize + (HOTBAR_SLOTS - 1) * padding;
-    int startX = (screenW - totalW) / 2;
+static HudCache gHud;
 
-    int frame = (int)(hb->animTimer * MASK_FPS) % TOTAL_FRAMES;
+static HotbarLayout MakeLayout(const View& view, int barY) {
+    HotbarLayout l;
+    l.barY = barY;
+    l.slotSize = view.uiHeight * 0.8;
+    l.padding = 12;
 
-    DrawText(TextFormat("COHERENCE: %d", maskUses), (float)(startX + 0.45 * slotSize), (float)(barY - UI_HEIGHT * 0.014f), 
-            slotSize / 6, maskUses > 1 ? RAYWHITE : RED);
+    int totalW = HOTBAR_SLOTS * l.slotSize + (HOTBAR_SLOTS - 1) * l.padding;
+    l.startX = (view.renderW - totalW) / 2;
+    l.slotY = barY + (view.uiHeight - l.slotSize) / 2;
+    l.label = l.slotSize / 6;
+    return l;
+}
+
+static Rectangle SlotRect(const HotbarLayout& l, int i) {
+    return Rectangle{ (float)l.SlotX(i), (float)l.slotY, (float)l.slotSize, (float)l.slotSize };
+}
+
+// everything but the selected slot's animation and the label
+static void DrawHotbarStatic(const Hotbar* hb, const HotbarLayout& l, int screenW, int uiHeight) {
+    DrawRectangle(0, l.barY, screenW, uiHeight, BLACK);
+
+    // labels go out in one batch after the slots, they never overlap another slot
+    TextBatchBegin();
 
     for (int i = 0; i < HOTBAR_SLOTS; i++) {
-        int x = startX + i * (slotSize + padding);
-        int y = barY + (UI_HEIGHT - slotSize) / 2;
+        Rectangle dst = SlotRect(l, i);
 
-        DrawRectangle(x, y, slotSize, slotSize, BLACK);
+        DrawRectangleRec(dst, BLACK);
 
         if (i == hb->selected) {
-            DrawRectangleLinesEx(
-                Rectangle{ (float)x, (float)y, (float)slotSize, (float)slotSize },
-                3,
-                YELLOW
-            );
+            DrawRectangleLinesEx(dst, 3, YELLOW);
+            continue;
         }
 
-        if (hb->slots[i].mask == MASK_NONE) continue;
+        int clip = hb->slots[i].clip;
+        if (hb->slots[i].mask == MASK_NONE || clip == ANIM_NONE) continue;
 
-        int useFrame = (i == hb->selected) ? frame : 0;
-        int col = useFrame % SHEET_COLS;
-        int row = useFrame / SHEET_COLS;
+        AnimDraw(clip, 0, dst);
 
-        Rectangle src = {
-            (float)(col * SPRITE_SIZE),
-            (float)(row * SPRITE_SIZE),
-            (float)SPRITE_SIZE,
-            (float)SPRITE_SIZE
-        };
+        TextBatchDraw(TextFormat("%d", i + 1), (int)(dst.x + l.slotSize * (
+                    i == 0 ? 0.325f : 0.2f)), l.slotY, (int)(l.slotSize * 1.25f), {255,255,255,168});
+    }
 
-        Rectangle dst = {
-            (float)x,
-            (float)y,
-            (float)slotSize,
-            (float)slotSize
-        };
+    TextBatchFlush();
+}
 
-        DrawTexturePro(
-            hb->slots[i].texture,
-            src,
-            dst,
-            {0, 0},
-            0.0f,
-            WHITE
-        );
+void HotbarPrepare(const Hotbar* hb, const View& view) {
+    HudCache& hud = gHud;
 
-        if (i != hb->selected) 
-            DrawText(TextFormat("%d", i + 1), (float)x + slotSize * (
-                        i == 0 ? 0.325f : 0.2f), (float)y, slotSize * 1.25f, {255,255,255,168});
-    }
+    bool stale = hud.selected != hb->selected ||
+                 hud.screenW != view.renderW ||
+                 hud.screenH != view.renderH ||
+                 hud.uiHeight != view.uiHeight;
+
+    if (!stale) return;
+
+    HotbarLayout l = MakeLayout(view, 0);
+
+    RTPoolResize(hud.target, view.renderW, view.uiHeight);
+
+    BeginTextureMode(hud.target.rt);
+    ClearBackground(BLANK);
+    DrawHotbarStatic(hb, l, view.renderW, view.uiHeight);
+    EndTextureMode();
+
+    hud.selected = hb->selected;
+    hud.screenW = view.renderW;
+    hud.screenH = view.renderH;
+    hud.uiHeight = view.uiHeight;
 }
 
-struct NoiseText {
-    std::string text;
-    Vector2 pos;
-    Vector2 vel;
-    float size;
-    float lifetime;
+void HotbarDraw(const Hotbar* hb, int maskUses, const View& view) {
+    HotbarLayout l = MakeLayout(view, view.renderH - view.uiHeight);
 
-    float rage;        // 0–1 intensity
-    float shakePhase;  // for oscillation and such
-};
+    // premultiplied, same as the world layer
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTextureRec(gHud.target.rt.texture, RTPoolSource(gHud.target),
+                   Vector2{ 0, (float)l.barY }, WHITE);
+    EndBlendMode();
 
-struct UINoise {
-    std::vector<NoiseText> lines;
-    Rectangle bounds;
-};
+    if (hb->selected >= 0) {
+        const HotbarSlot& slot = hb->slots[hb->selected];
+        if (slot.mask != MASK_NONE && slot.clip != ANIM_NONE)
+            AnimDraw(slot.clip, AnimFrameAt(slot.clip, hb->animTimer), SlotRect(l, hb->selected));
+    }
+
+    // after the sprite, text went on top of everything before the cache too
+    TextBatchBegin();
+    TextBatchDraw(TextFormat("COHERENCE: %d", maskUses), (int)(l.startX + 0.45 * l.slotSize),
+            (int)(l.barY - view.uiHeight * 0.014f), l.label, maskUses > 1 ? RAYWHITE : RED);
+    TextBatchFlush();
+}
 
-static UINoise gNoise;
+void HotbarShutdown() {
+    RTPoolRelease(gHud.target);
+    gHud = HudCache{};
+}
+
+// one pool for every mask's lines, loaded once, particles hold indices
+static std::vector<std::string> gNoiseStrings;
+static int gNoiseFirst[MASK_WIND + 1];
+static int gNoiseCount[MASK_WIND + 1];
+
+static Particles gNoise;
+static Rectangle gNoiseBounds;
 static MaskType gLastMask = MASK_NONE;
 
-static std::vector<std::string> LoadNoiseLines(const std::string& path) {
-    std::vector<std::string> out;
+static void LoadNoiseLines(MaskType mask, const std::string& path) {
+    gNoiseFirst[mask] = (int)gNoiseStrings.size();
+
     std::ifstream f(path);
     std::string line;
-
     while (std::getline(f, line)) {
         if (!line.empty())
-            out.push_back(line);
+            gNoiseStrings.push_back(line);
     }
-    return out;
+
+    gNoiseCount[mask] = (int)gNoiseStrings.size() - gNoiseFirst[mask];
 }
 
-void UINoiseInit() {
-    gNoise.bounds = {
+static Rectangle NoiseBounds() {
+    return Rectangle{
         0,
         (float)GetScreenHeight() - UI_HEIGHT,
         (float)GetScreenWidth(),
@@ -159,46 +204,51 @@ void UINoiseInit() {
     };
 }
 
-void UINoiseOnMaskChanged(MaskType mask) {
-    if (mask == gLastMask) return;
-    gLastMask = mask;
+// the shake phase never moves, so the shake direction and the pulse are
+// fixed per line, only the rage scales the shake later
+static void NoiseSpawnShape(int i) {
+    float phase = ParticleRange(gNoise, i, 0.0f, 1.0f);
+
+    gNoise.ox[i] = sinf(phase * 12.0f);
+    gNoise.oy[i] = cosf(phase * 9.0f);
+    gNoise.size[i] = ParticleRange(gNoise, i, TILE_SIZE * 2, TILE_SIZE * 3.5f) *
+                     (0.75f + sinf(phase * 0.7f) * 0.1f);
+}
 
-    gNoise.lines.clear();
+void UINoiseInit() {
+    gNoiseBounds = NoiseBounds();
 
-    std::string path;
-    switch (mask) {
-        case MASK_STONE: path = "assets/text/stone.txt"; break;
-        case MASK_WIND:  path = "assets/text/wind.txt";  break;
-        default: return;
+    if (gNoiseStrings.empty()) {
+        LoadNoiseLines(MASK_STONE, "assets/text/stone.txt");
+        LoadNoiseLines(MASK_WIND,  "assets/text/wind.txt");
     }
 
-    auto pool = LoadNoiseLines(path);
-    if (pool.empty()) return;
-
-    for (int i = 0; i < 40; i++) {
-        NoiseText t;
-        t.text = pool[GetRandomValue(0, pool.size() - 1)];
-        t.pos = {
-            (float)GetRandomValue(
-                    (int)gNoise.bounds.x,
-                    (int)(gNoise.bounds.x + gNoise.bounds.width)
-                    ),
-            (float)GetRandomValue(
-                    (int)gNoise.bounds.y,
-                    (int)(gNoise.bounds.y + gNoise.bounds.height)
-                    )
-        };
-        t.vel = {
-            GetRandomValue(-40, 40) / 1.0f,
-            GetRandomValue(-35, 35) / 1.0f
-        };
-        t.size = GetRandomValue(TILE_SIZE * 2, TILE_SIZE * 3.5);
-        t.lifetime = GetRandomValue(1, 5);
+    ParticlesResize(gNoise, 0, 0);
+    gLastMask = MASK_NONE;
+}
+
+void UINoiseOnMaskChanged(MaskType mask) {
+    if (mask == gLastMask) return;
+    gLastMask = mask;
 
-        t.rage = GetRandomValue(40, 100) / 100.0f;  // 0.4 – 1.0
-        t.shakePhase = GetRandomValue(0, 1000) / 1000.0f;
+    int pool = (mask == MASK_NONE) ? 0 : gNoiseCount[mask];
+    if (pool == 0) {
+        gNoise.count = 0;
+        return;
+    }
 
-        gNoise.lines.push_back(t);
+    ParticlesResize(gNoise, UI_NOISE_COUNT, RngNext(RngGet(RNG_UI)));
+
+    const Rectangle& b = gNoiseBounds;
+    for (int i = 0; i < gNoise.count; i++) {
+        gNoise.payload[i] = (uint16_t)(gNoiseFirst[mask] + ParticleRand(gNoise, i) % pool);
+        gNoise.x[i] = ParticleRange(gNoise, i, b.x, b.x + b.width);
+        gNoise.y[i] = ParticleRange(gNoise, i, b.y, b.y + b.height);
+        gNoise.vx[i] = ParticleRange(gNoise, i, -40.0f, 40.0f);
+        gNoise.vy[i] = ParticleRange(gNoise, i, -35.0f, 35.0f);
+        gNoise.life[i] = (float)(1 + ParticleRand(gNoise, i) % 5);
+        gNoise.rage[i] = ParticleRange(gNoise, i, 0.4f, 1.0f);
+        NoiseSpawnShape(i);
     }
 }
 
@@ -206,83 +256,69 @@ void UINoiseOnMaskChanged(MaskType mask) {
 void UINoiseUpdate(float dt) {
     float damping = powf(0.98f, dt * 60.0f);
 
-    for (auto& t : gNoise.lines) {
-        t.pos.x += t.vel.x * dt;
-        t.pos.y += t.vel.y * dt;
-
-        t.vel.x *= damping;
-        t.vel.y *= damping;
-
-        // float shake = 3.0f + 10.0f * t.rage;
-        // t.shakePhase += dt * (8.0f + 12.0f * t.rage);
-
-        // t.pos.x += sinf(t.shakePhase * 12.0f) * shake * dt;
-        // t.pos.y += cosf(t.shakePhase * 9.0f)  * shake * dt;
+    ParticlesIntegrate(gNoise, dt, damping);
 
-        if (GetRandomValue(0, 1000) < 5) {
-            t.vel.x += GetRandomValue(-20, 20) / 10.0f;
-            t.vel.y += GetRandomValue(-15, 15) / 10.0f;
-        }
+    // 0.5% per 60 Hz frame, whatever the actual rate
+    ParticlesNudge(gNoise, 0.005f * dt * 60.0f, 2.0f, 1.5f);
 
-        t.lifetime -= dt;
-        if (t.lifetime <= 0.0f) {
-            t.vel.x += GetRandomValue(-15, 15) * 5.5f;
-            t.vel.y += GetRandomValue(-10, 10) * 5.5f;
-            t.lifetime = GetRandomValue(1, 5);
-            t.rage = GetRandomValue(40, 100) / 100.0f;
-        }
+    ParticlesAge(gNoise, dt);
+    for (int i = 0; i < gNoise.count; i++) {
+        if (gNoise.life[i] > 0.0f) continue;
 
-        if (t.pos.x < gNoise.bounds.x) t.pos.x += gNoise.bounds.width;
-        if (t.pos.y < gNoise.bounds.y) t.pos.y += gNoise.bounds.height;
-        if (t.pos.x > gNoise.bounds.x + gNoise.bounds.width) t.pos.x -= gNoise.bounds.width;
-        if (t.pos.y > gNoise.bounds.y + gNoise.bounds.height) t.pos.y -= gNoise.bounds.height;
+        gNoise.vx[i] += ParticleRange(gNoise, i, -15.0f, 15.0f) * 5.5f;
+        gNoise.vy[i] += ParticleRange(gNoise, i, -10.0f, 10.0f) * 5.5f;
+        gNoise.life[i] = (float)(1 + ParticleRand(gNoise, i) % 5);
+        gNoise.rage[i] = ParticleRange(gNoise, i, 0.4f, 1.0f);
     }
+
+    ParticlesWrap(gNoise, gNoiseBounds);
 }
 
 
-void UINoiseDraw() {
-    for (const auto& t : gNoise.lines) {
-        unsigned char r = (unsigned char)GetRandomValue(180, 255);
-        unsigned char g = (unsigned char)GetRandomValue(0, 60);
-        unsigned char b = (unsigned char)GetRandomValue(0, 40);
+const Particles& UINoiseParticles() {
+    return gNoise;
+}
 
-        unsigned char a = (unsigned char)GetRandomValue(70, 130);
+// Noise lives in window pixels, scaled down into the render target here
+void UINoiseDraw(const View& view, Particles& noise) {
+    float inv = 1.0f / view.pixelScale;
 
-        Color c = { r, g, b, a };
+    TextBatchBegin();
 
-        float pulse = 0.75f + sinf(t.shakePhase * 0.7f) * 0.1f;
-        
-        float shake = 3.0f + 10.0f * t.rage;
+    for (int i = 0; i < noise.count; i++) {
+        // per frame flicker, one draw split into the channels
+        uint32_t r = ParticleRand(noise, i);
+        Color c = {
+            (unsigned char)(180 + (r & 0xff) % 76),
+            (unsigned char)(((r >> 8) & 0xff) % 61),
+            (unsigned char)(((r >> 16) & 0xff) % 41),
+            (unsigned char)(70 + (r >> 24) % 61)
+        };
 
-        float sx = sinf(t.shakePhase * 12.0f) * shake;
-        float sy = cosf(t.shakePhase * 9.0f)  * shake;
+        float shake = 3.0f + 10.0f * noise.rage[i];
 
-        DrawText(
-            t.text.c_str(),
-            (int)(t.pos.x + sx),
-            (int)(t.pos.y + sy),
-            (int)(t.size * pulse),
+        TextBatchDraw(
+            gNoiseStrings[noise.payload[i]].c_str(),
+            (int)((noise.x[i] + noise.ox[i] * shake) * inv),
+            (int)((noise.y[i] + noise.oy[i] * shake) * inv),
+            (int)(noise.size[i] * inv),
             c
         );
     }
+
+    TextBatchFlush();
 }
 
 void UINoiseOnResize() {
-    Rectangle old = gNoise.bounds;
-
-    gNoise.bounds = {
-        0,
-        (float)GetScreenHeight() - UI_HEIGHT,
-        (float)GetScreenWidth(),
-        (float)UI_HEIGHT
-    };
+    Rectangle old = gNoiseBounds;
+    gNoiseBounds = NoiseBounds();
 
     // Reposition existing noise proportionally
-    for (auto& t : gNoise.lines) {
-        float nx = (t.pos.x - old.x) / old.width;
-        float ny = (t.pos.y - old.y) / old.height;
+    for (int i = 0; i < gNoise.count; i++) {
+        float nx = (gNoise.x[i] - old.x) / old.width;
+        float ny = (gNoise.y[i] - old.y) / old.height;
 
-        t.pos.x = gNoise.bounds.x + nx * gNoise.bounds.width;
-        t.pos.y = gNoise.bounds.y + ny * gNoise.bounds.height;
+        gNoise.x[i] = gNoiseBounds.x + nx * gNoiseBounds.width;
+        gNoise.y[i] = gNoiseBounds.y + ny * gNoiseBounds.height;
     }
 }
@@ -3,10 +3,12 @@
 #include "mask.h"
 #include "config.h"
 #include "world.h"
+#include "view.h"
+#include "particles.h"
 
 struct HotbarSlot {
     MaskType mask;
-    Texture2D texture;
+    int clip;       // mask_<name> in ANIM_FILE
 };
 
 struct Hotbar {
@@ -16,11 +18,20 @@ struct Hotbar {
 };
 
 void HotbarInit(Hotbar* hb);
-void HotbarUpdate(Hotbar* hb, float dt, int* maskUses, bool playerMoving);
-void HotbarDraw(const Hotbar* hb, int maskUses);
+// slot whose key went down this frame or -1, main thread only (raylib input)
+int HotbarPressedSlot();
+void HotbarUpdate(Hotbar* hb, float dt, int* maskUses, bool playerMoving, int pressedSlot);
+// redraws the cached strip if anything on it changed, before
+// BeginTextureMode on the main target, texture modes don't nest
+void HotbarPrepare(const Hotbar* hb, const View& view);
+// cached strip, then the selected mask's animation and the COHERENCE label
+void HotbarDraw(const Hotbar* hb, int maskUses, const View& view);
+void HotbarShutdown();
 MaskType HotbarGetSelectedMask(const Hotbar* hb);
 void UINoiseInit();
 void UINoiseOnMaskChanged(MaskType mask);
 void UINoiseUpdate(float dt); 
-void UINoiseDraw(); 
+// the live particles, render from a copy when the simulation runs ahead
+const Particles& UINoiseParticles();
+void UINoiseDraw(const View& view, Particles& noise);
 void UINoiseOnResize();
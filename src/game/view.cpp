@@ -2,8 +2,26 @@
 #include <algorithm>
 
 void View::Recalculate() {
-    screenW = GetScreenWidth();
-    screenH = GetScreenHeight() - UI_HEIGHT;
+    Recalculate(GetScreenWidth(), GetScreenHeight());
+}
+
+void View::Recalculate(int windowW, int windowH) {
+#if PIXEL_PERFECT
+    // biggest integer scale that still gives each tile PIXEL_PERFECT_TILE px
+    int fullTile = std::min(windowW / gridW, (windowH - UI_HEIGHT) / gridH);
+    pixelScale = std::max(1, fullTile / PIXEL_PERFECT_TILE);
+#else
+    pixelScale = 1;
+#endif
+    pixelScale *= std::max(1, downscale);
+
+    // round up so the upscaled target always covers the window
+    renderW  = (windowW + pixelScale - 1) / pixelScale;
+    renderH  = (windowH + pixelScale - 1) / pixelScale;
+    uiHeight = UI_HEIGHT / pixelScale;
+
+    screenW = renderW;
+    screenH = renderH - uiHeight;
 
     tileSize = std::min(
         screenW / gridW,
@@ -3,7 +3,7 @@
 #include <raylib.h>
 
 struct View {
-    int screenW;
+    int screenW;     // gameplay area, in render pixels
     int screenH;
 
     int gridW;
@@ -13,6 +13,15 @@ struct View {
     int offsetX;
     int offsetY;
 
-    void Recalculate();
+    // Internal framebuffer. Everything in the render target is drawn at
+    // renderW x renderH and blown up by pixelScale in the final CRT pass.
+    int pixelScale;
+    int renderW;
+    int renderH;
+    int uiHeight;    // hotbar strip, in render pixels
+    int downscale = 1;  // extra divisor from the post-fx quality controller
+
+    void Recalculate();                          // main thread, asks raylib
+    void Recalculate(int windowW, int windowH);  // any thread
     Vector2 GridToWorld(int gx, int gy) const;
 };
@@ -1,5 +1,29 @@
 #include "world.h"
+#include "anim.h"
+
+
+bool ParseTile(const std::string& name, Tile& out) {
+    static const struct { const char* name; Tile tile; } TILE_NAMES[] = {
+        { "TILE_EMPTY",              TILE_EMPTY },
+        { "TILE_WALL",               TILE_WALL },
+        { "TILE_FLAME",              TILE_FLAME },
+        { "TILE_PIT",                TILE_PIT },
+        { "TILE_GOAL",               TILE_GOAL },
+        { "TILE_GLASS",              TILE_GLASS },
+        { "TILE_PRESSUREPLATE",      TILE_PRESSUREPLATE },
+        { "TILE_PRESSUREPLATE_USED", TILE_PRESSUREPLATE_USED },
+        { "TILE_DOOR_CLOSED",        TILE_DOOR_CLOSED },
+        { "TILE_DOOR_OPEN",          TILE_DOOR_OPEN },
+    };
 
+    for (const auto& t : TILE_NAMES) {
+        if (name == t.name) {
+            out = t.tile;
+            return true;
+        }
+    }
+    return false;
+}
 
 Tile World::Get(int x, int y) const {
     return tiles[y * width + x];
@@ -17,6 +41,7 @@ bool World::ActivatePlate(int x, int y) {
     }
     int idx = y * width + x;
     t = tiles[idx] = TILE_PRESSUREPLATE_USED;
+    revision++;
     for (int dy = 0; dy < height; dy++) {
         for (int dx = 0; dx < width; dx++) {
             int id = dy * width + dx; 
@@ -67,12 +92,24 @@ bool World::IsDeadly(int x, int y, MaskType mask) const {
 
 TileTextures gTiles; 
 
-void World::DrawOutlines(const View& view) const {
+bool IsAnimatedTile(Tile tile) {
+    return AnimTileClip(tile) != ANIM_NONE;
+}
+
+void World::DrawOutlines(const View& view, bool nearAnimated) const {
+    auto animated = [&](int x, int y) {
+        return InBounds(x, y) && IsAnimatedTile(Get(x, y));
+    };
+
     for (int y = 0; y < height; y++) {
         for (int x = 0; x < width; x++) {
 
             if (Get(x, y) != TILE_WALL) continue;
 
+            if (nearAnimated &&
+                !animated(x, y - 1) && !animated(x, y + 1) &&
+                !animated(x - 1, y) && !animated(x + 1, y)) continue;
+
             Vector2 pos = view.GridToWorld(x, y);
             float s = view.tileSize;
 
@@ -119,56 +156,37 @@ void World::DrawOutlines(const View& view) const {
     }
 }
 
-constexpr int GOAL_FRAME_SIZE = 32;
-constexpr int GOAL_FRAMES = 32;
-constexpr int GOAL_COLUMNS = 6;
-constexpr float GOAL_FPS = 12.0f;
-
-int GetGoalFrame() {
-    float time = GetTime();  // raylib global time
-    int frame = (int)(time * GOAL_FPS) % GOAL_FRAMES;
-    return frame;
-}
-
-Rectangle GetGoalSrcRect(int frame) {
-    int col = frame % GOAL_COLUMNS;
-    int row = frame / GOAL_COLUMNS;
-
-    return Rectangle{
-        (float)(col * GOAL_FRAME_SIZE),
-        (float)(row * GOAL_FRAME_SIZE),
-        (float)GOAL_FRAME_SIZE,
-        (float)GOAL_FRAME_SIZE
-    };
+void World::Draw(const View& view) const {
+    DrawStatic(view);
+    DrawAnimated(view);
 }
 
-constexpr int FLAME_FRAME_SIZE = 32;
-constexpr int FLAME_FRAMES = 16;
-constexpr int FLAME_COLUMNS = 4;
-constexpr float FLAME_FPS = 12.0f;
+void World::DrawAnimated(const View& view) const {
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int clip = AnimTileClip(Get(x, y));
+            if (clip == ANIM_NONE) continue;
 
-int GetFlameFrame() {
-    float time = GetTime();  // raylib global time
-    int frame = (int)(time * FLAME_FPS) % FLAME_FRAMES;
-    return frame;
-}
+            Vector2 pos = view.GridToWorld(x, y);
 
-Rectangle GetFlameSrcRect(int frame) {
-    int col = frame % FLAME_COLUMNS;
-    int row = frame / FLAME_COLUMNS;
+            Rectangle dst = {
+                pos.x,
+                pos.y,
+                (float)view.tileSize,
+                (float)view.tileSize
+            };
 
-    return Rectangle{
-        (float)(col * FLAME_FRAME_SIZE),
-        (float)(row * FLAME_FRAME_SIZE),
-        (float)FLAME_FRAME_SIZE,
-        (float)FLAME_FRAME_SIZE
-    };
+            AnimDraw(clip, AnimCurrentFrame(clip), dst);
+        }
+    }
 }
 
-void World::Draw(const View& view) const {
+void World::DrawStatic(const View& view) const {
     for (int y = 0; y < height; y++) {
         for (int x = 0; x < width; x++) {
             Tile t = Get(x, y);
+            if (IsAnimatedTile(t)) continue;   // DrawAnimated
+
             Vector2 pos = view.GridToWorld(x, y);
 
             Rectangle dst = {
@@ -212,48 +230,6 @@ void World::Draw(const View& view) const {
                     );
                 } break;
 
-                case TILE_GOAL: {
-                    int frame = GetGoalFrame();
-                    Rectangle src = GetGoalSrcRect(frame);
-
-                    Rectangle dst = {
-                        pos.x,
-                        pos.y,
-                        (float)view.tileSize,
-                        (float)view.tileSize
-                    };
-
-                    DrawTexturePro(
-                        gTiles.goal,
-                        src,
-                        dst,
-                        Vector2{0, 0},
-                        0.0f,
-                        WHITE
-                    );
-                } break;
-
-                case TILE_FLAME: {
-                    int frame = GetFlameFrame();
-                    Rectangle src = GetFlameSrcRect(frame);
-
-                    Rectangle dst = {
-                        pos.x,
-                        pos.y,
-                        (float)view.tileSize,
-                        (float)view.tileSize
-                    };
-
-                    DrawTexturePro(
-                        gTiles.flame,
-                        src,
-                        dst,
-                        Vector2{0, 0},
-                        0.0f,
-                        WHITE
-                    );
-                } break;
-
                 case TILE_PIT: {
                     Vector2 pos = view.GridToWorld(x, y);
 
@@ -526,8 +502,6 @@ void World::Draw(const View& view) const {
 void LoadTileTextures() {
     gTiles.wall = LoadTexture("assets/tiles/wall.png");
     gTiles.empty = LoadTexture("assets/tiles/empty.png");
-    gTiles.goal = LoadTexture("assets/tiles/goal.png");
-    gTiles.flame = LoadTexture("assets/tiles/flame.png");
 
 
     gTiles.empty_edge_top = LoadTexture("assets/tiles/EMPTY_EDGE_TOP.png");
@@ -548,8 +522,6 @@ void LoadTileTextures() {
 
     SetTextureFilter(gTiles.wall, TEXTURE_FILTER_POINT);
     SetTextureFilter(gTiles.empty, TEXTURE_FILTER_POINT);
-    SetTextureFilter(gTiles.goal, TEXTURE_FILTER_POINT);
-    SetTextureFilter(gTiles.flame, TEXTURE_FILTER_POINT);
 
     SetTextureFilter(gTiles.empty_edge_top, TEXTURE_FILTER_POINT);
     SetTextureFilter(gTiles.empty_edge_right, TEXTURE_FILTER_POINT);
@@ -571,8 +543,6 @@ void LoadTileTextures() {
 void UnloadTileTextures() {
     UnloadTexture(gTiles.wall);
     UnloadTexture(gTiles.empty);
-    UnloadTexture(gTiles.goal);
-    UnloadTexture(gTiles.flame);
 
     UnloadTexture(gTiles.empty_edge_top);
     UnloadTexture(gTiles.empty_edge_right);
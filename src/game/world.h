@@ -1,6 +1,7 @@
 #pragma once
 #include <raylib.h>
 #include "../config.h"
+#include <string>
 #include <vector>
 #include "view.h"
 #include "mask.h"
@@ -21,8 +22,6 @@ enum Tile {
 struct TileTextures {
     Texture2D wall;
     Texture2D empty;
-    Texture2D goal;
-    Texture2D flame;
     Texture2D empty_edge_top;
     Texture2D empty_edge_bottom;
     Texture2D empty_edge_left;
@@ -47,15 +46,27 @@ struct World {
     int width;
     int height;
     std::vector<Tile> tiles;
+    int revision = 0;   // bumped whenever tiles change, for cached layers
 
     Tile Get(int x, int y) const;
     bool InBounds(int x, int y) const;
     bool IsDeadly(int x, int y, MaskType mask) const;
     bool IsWalkable(int x, int y, MaskType mask) const;
     void Draw(const View& view) const;
-    void DrawOutlines(const View& view) const;
+
+    // Draw() split in two: everything that only changes with revision, and
+    // the tiles with a clip in ANIM_FILE, which leave holes in the static part
+    void DrawStatic(const View& view) const;
+    void DrawAnimated(const View& view) const;
+
+    // nearAnimated redraws only the walls touching an animated tile, their
+    // outline bleeds into the neighbour and gets covered by DrawAnimated
+    void DrawOutlines(const View& view, bool nearAnimated = false) const;
     bool ActivatePlate(int x, int y);
 };
 
+bool IsAnimatedTile(Tile tile);   // has a TILE clip in ANIM_FILE
+
 bool IsWalkable(Tile tile);
+bool ParseTile(const std::string& name, Tile& out);  // "TILE_WALL" etc
 void OnEnterTile(Tile tile);
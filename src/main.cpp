@@ -2,17 +2,32 @@
 #include <filesystem>
 #include <raylib.h>
 #include <cmath>
-#include <fstream>
 #include <unordered_set>
 
 #include "config.h"
 #include "game/player.h"
 #include "game/world.h"
+#include "game/anim.h"
 #include "game/mask.h"
 #include "game/ui.h"
 #include "game/level.h"
 #include "game/sound.h"
 #include "game/save.h"
+#include "game/catalogue.h"
+#include "game/thumbnail.h"
+#include "game/profile.h"
+#include "game/frameprof.h"
+#include "game/clock.h"
+#include "game/headless.h"
+#include "game/audiotest.h"
+#include "game/mixer.h"
+#include "game/textbatch.h"
+#include "game/menuquotes.h"
+#include "game/rng.h"
+#include "game/simthread.h"
+#include "game/pacer.h"
+#include "game/postfx.h"
+#include "game/rtpool.h"
 
 #include <algorithm>
 
@@ -27,32 +42,13 @@ enum class GameState {
 struct LevelEntry {
     std::string name;      
     std::string path;      
+    int64_t mtime;
     bool known;
+    bool invalid;          // failed to parse
 };
 
 static std::vector<LevelEntry> gLevelList;
-
-struct FloatingQuote {
-    std::string text;
-    Vector2 pos;
-    Vector2 vel;
-    float rotation;
-    float alpha;
-};
-
-static std::vector<FloatingQuote> gMenuQuotes;
-
-std::vector<std::string> LoadLines(const char* path) {
-    std::vector<std::string> lines;
-    std::ifstream f(path);
-    std::string line;
-
-    while (std::getline(f, line)) {
-        if (!line.empty())
-            lines.push_back(line);
-    }
-    return lines;
-}
+static unsigned int gLevelListGeneration = 0;
 
 static float levelScroll = 0.0f;
 
@@ -77,6 +73,18 @@ struct DeathFlash {
 
 constexpr float DEATH_FLASH_DURATION = 0.5f;
 
+// Stats for the current go at a level, reset on every (re)load
+struct Attempt {
+    int moves = 0;
+    float time = 0.0f;
+    bool cleared = false;
+};
+
+static Attempt gAttempt;
+
+// bumped by InitializeFromLevel, World::revision alone repeats across loads
+static int gLevelEpoch = 0;
+
 const char* DeathText(DeathReason reason) {
 
     const char* msg = "YOU DIED";
@@ -108,68 +116,6 @@ bool AnyMovementKeyDown() {
            IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D);
 }
 
-void DrawMenuFloatingText(float dt) {
-    for (auto& q : gMenuQuotes) {
-        q.pos.x += q.vel.x * dt * 20.0f;
-        q.pos.y += q.vel.y * dt * 20.0f;
-
-        // Soft wrap
-        if (q.pos.x < -200) q.pos.x = GetScreenWidth() + 200;
-        if (q.pos.x > GetScreenWidth() + 200) q.pos.x = -200;
-        if (q.pos.y < -100) q.pos.y = GetScreenHeight() + 100;
-        if (q.pos.y > GetScreenHeight() + 100) q.pos.y = -100;
-
-        // Subtle alpha flicker
-        float flicker = GetRandomValue(-5, 5) / 1000.0f;
-        q.alpha = std::clamp(q.alpha + flicker, 0.2f, 0.9f);
-
-        Color c = Color{200, 30, 30, (unsigned char)(255 * q.alpha)};
-
-        DrawTextPro(
-            GetFontDefault(),
-            q.text.c_str(),
-            q.pos,
-            Vector2{0, 0},
-            q.rotation,
-            20,
-            1,
-            c
-        );
-    }
-}
-
-void InitMenuQuotes() {
-    auto stone = LoadLines("assets/text/stone.txt");
-    auto wind  = LoadLines("assets/text/wind.txt");
-
-    std::vector<std::string> all;
-    all.insert(all.end(), stone.begin(), stone.end());
-    all.insert(all.end(), wind.begin(), wind.end());
-
-    gMenuQuotes.clear();
-
-    for (int i = 0; i < 67; i++) {
-        FloatingQuote q;
-        q.text = all[GetRandomValue(0, all.size() - 1)];
-
-        q.pos = {
-            (float)GetRandomValue(0, GetScreenWidth()),
-            (float)GetRandomValue(0, GetScreenHeight())
-        };
-
-        q.vel = {
-            GetRandomValue(-10, 10) / 10.0f,
-            GetRandomValue(-10, 10) / 10.0f
-        };
-
-        q.rotation = GetRandomValue(-25, 25);
-        q.alpha = GetRandomValue(30, 90) / 100.0f;
-
-        gMenuQuotes.push_back(q);
-    }
-}
-
-
 bool DrawMenuButton(const char* text, Rectangle rect) {
     Vector2 mouse = GetMousePosition();
     bool hover = CheckCollisionPointRec(mouse, rect);
@@ -231,12 +177,17 @@ void DrawPauseMenu(bool& resumeClicked, bool& restartClicked, bool& menuClicked)
     }
 }
 
-void InitializeFromLevel(Level* level, View* view, Player* p, Hotbar* hb) {
+// window size passed in, the sim thread can't ask raylib for it
+void InitializeFromLevel(Level* level, View* view, Player* p, Hotbar* hb, int windowW, int windowH) {
+    PROFILE_SCOPE("InitializeFromLevel");
+
     view->gridW = level->world.width;
     view->gridH = level->world.height;
-    view->Recalculate();
+    view->Recalculate(windowW, windowH);
+    gLevelEpoch++;
 
     PlayerInit(p, level->spawnX, level->spawnY, *view);
+    gAttempt = Attempt{};
     p->mask = level->startMask;
     p->maskUses = level->maskUses;
 
@@ -249,6 +200,154 @@ void InitializeFromLevel(Level* level, View* view, Player* p, Hotbar* hb) {
     }
 }
 
+void InitializeFromLevel(Level* level, View* view, Player* p, Hotbar* hb) {
+    InitializeFromLevel(level, view, p, hb, GetScreenWidth(), GetScreenHeight());
+}
+
+// Points the internal framebuffer at the view's size. Pooled, so this only
+// allocates when the target has to grow (or is way too big)
+void SyncRenderTarget(PooledTarget& target, const View& view) {
+    RTPoolResize(target, view.renderW, view.renderH);
+}
+
+// Window drags fire a resize every frame, only re-layout once it settles.
+// Until then the old frame just keeps being drawn at the old size.
+static float gResizeTimer = 0.0f;
+
+void UpdateResize(float dt, View& view, Player& player) {
+    if (IsWindowResized()) {
+        gResizeTimer = RESIZE_SETTLE;
+        return;
+    }
+
+    if (gResizeTimer <= 0.0f) return;
+    gResizeTimer -= dt;
+    if (gResizeTimer > 0.0f) return;
+
+    view.Recalculate();
+    PlayerSyncVisual(&player, view);
+    UINoiseOnResize();
+}
+
+// Integer upscale of the internal framebuffer, may overhang the window edge
+Rectangle UpscaledRect(const View& view) {
+    return Rectangle{
+        0, 0,
+        (float)(view.renderW * view.pixelScale),
+        (float)(view.renderH * view.pixelScale)
+    };
+}
+
+// ------------------------------------------------------------
+// Static world layer. Tiles only change on load or when a plate flips the
+// doors, so they live in their own target and only goal/flame get redrawn.
+// ------------------------------------------------------------
+
+struct WorldLayer {
+    PooledTarget target;
+    int epoch = -1;
+    int revision = -1;
+    int tileSize = 0;
+    int offsetX = 0;
+    int offsetY = 0;
+};
+
+static WorldLayer gWorldLayer;
+
+// before BeginTextureMode on the main target, texture modes don't nest
+void UpdateWorldLayer(const World& world, const View& view, int epoch) {
+    WorldLayer& layer = gWorldLayer;
+
+    bool stale = layer.epoch != epoch ||
+                 layer.revision != world.revision ||
+                 layer.tileSize != view.tileSize ||
+                 layer.offsetX != view.offsetX ||
+                 layer.offsetY != view.offsetY ||
+                 layer.target.width != view.renderW ||
+                 layer.target.height != view.renderH;
+
+    if (!stale) return;
+
+    RTPoolResize(layer.target, view.renderW, view.renderH);
+
+    BeginTextureMode(layer.target.rt);
+    ClearBackground(BLACK);
+    world.DrawStatic(view);
+    world.DrawOutlines(view);
+    EndTextureMode();
+
+    layer.epoch = epoch;
+    layer.revision = world.revision;
+    layer.tileSize = view.tileSize;
+    layer.offsetX = view.offsetX;
+    layer.offsetY = view.offsetY;
+}
+
+void DrawWorldCached(const World& world, const View& view) {
+    const WorldLayer& layer = gWorldLayer;
+
+    {
+        PROFILE_GPU_SCOPE("World static");
+
+        // premultiplied: the layer went onto black, its alpha isn't coverage
+        BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+        DrawTextureRec(layer.target.rt.texture, RTPoolSource(layer.target),
+                       Vector2{ 0, 0 }, WHITE);
+        EndBlendMode();
+    }
+    {
+        PROFILE_GPU_SCOPE("World animated");
+        world.DrawAnimated(view);
+    }
+    {
+        PROFILE_GPU_SCOPE("DrawOutlines");
+        world.DrawOutlines(view, true);
+    }
+}
+
+// ------------------------------------------------------------
+// Idle throttle
+// ------------------------------------------------------------
+
+static float gIdleTimer = 0.0f;
+static bool gIdle = false;
+
+// Polls key state instead of GetKeyPressed, that one pops raylib's queue
+// and whoever reads it after us would never see the key
+bool AnyKeyActive() {
+    for (int key = KEY_SPACE; key <= KEY_KP_EQUAL; key++) {
+        if (IsKeyDown(key) || IsKeyPressed(key)) return true;
+    }
+    return false;
+}
+
+bool AnyInput() {
+    Vector2 md = GetMouseDelta();
+
+    return AnyKeyActive() ||
+           md.x != 0.0f || md.y != 0.0f ||
+           GetMouseWheelMove() != 0.0f ||
+           IsMouseButtonDown(MOUSE_BUTTON_LEFT) ||
+           IsMouseButtonDown(MOUSE_BUTTON_RIGHT);
+}
+
+// busy = something on screen is moving that isn't just a looping animation
+void UpdateIdle(float dt, bool busy) {
+#if ENABLE_IDLE_THROTTLE
+    if (busy || AnyInput()) gIdleTimer = 0.0f;
+    else                    gIdleTimer += dt;
+
+    bool idle = gIdleTimer >= IDLE_AFTER;
+    if (idle == gIdle) return;
+
+    gIdle = idle;
+    PacerSetIdle(idle);
+#else
+    (void)dt;
+    (void)busy;
+#endif
+}
+
 bool GetHeldDirection(int& dx, int& dy) {
     dx = dy = 0;
 
@@ -274,26 +373,22 @@ bool GetHeldDirection(int& dx, int& dy) {
 
 void LoadLevelList() {
     gLevelList.clear();
+    gLevelListGeneration = CatalogueGeneration();
 
-    for (const auto& entry : std::filesystem::directory_iterator("levels")) {
-        if (!entry.is_regular_file()) continue;
-        if (entry.path().extension() != ".txt") continue;
-
+    // catalogue is already sorted by path
+    for (const auto& entry : CatalogueSnapshot()) {
         LevelEntry lvl;
-        lvl.path = NormalizePath(entry.path().string());
+        lvl.path = entry.path;
+        lvl.mtime = entry.mtime;
         lvl.known = HasRememberedLevel(lvl.path);
+        lvl.invalid = entry.invalid;
 
         lvl.name = lvl.known
-            ? entry.path().stem().string()
+            ? entry.name
             : "???";
 
         gLevelList.push_back(lvl);
     }
-
-    std::sort(gLevelList.begin(), gLevelList.end(),
-        [](const LevelEntry& a, const LevelEntry& b) {
-            return a.path < b.path;
-        });
 }
 
 void DrawLevelSelect(GameState& gameState,
@@ -301,12 +396,16 @@ void DrawLevelSelect(GameState& gameState,
                      View& view,
                      Player& player,
                      Hotbar& hotbar,
-                     RenderTexture2D& target,
                      bool& isDead,
                      float& deathTimer,
                      DeathFlash& deathFlash,
                      bool& movementLocked)
 {
+    // background scan finished, pick up new/changed levels
+    if (gLevelListGeneration != CatalogueGeneration()) {
+        LoadLevelList();
+    }
+
     BeginDrawing();
     ClearBackground(BLACK);
 
@@ -334,26 +433,40 @@ void DrawLevelSelect(GameState& gameState,
     float startY = SCREEN_HEIGHT/ 3.0f - levelScroll;
 
 
-    for (size_t i = 0; i < gLevelList.size(); i++) {
+    // only walk the rows that can actually be on screen
+    float rowH = bh + 12;
+    int first = std::max(0, (int)floorf((-bh - startY) / rowH));
+    int last  = std::min((int)gLevelList.size() - 1,
+                         (int)ceilf((GetScreenHeight() - startY) / rowH));
+
+    ThumbnailUpdate();
+
+    for (int i = first; i <= last; i++) {
         Rectangle r = {
             bx,
-            startY + i * (bh + 12),
+            startY + i * rowH,
             bw,
             bh
         };
 
-        if (r.y + r.height < 0 || r.y > GetScreenHeight())
-            continue; // cheap clipping
+        // listed so it doesn't just vanish, but there's nothing to load
+        if (gLevelList[i].invalid) {
+            DrawRectangleRec(r, Color{40, 10, 10, 180});
+            DrawText(TextFormat("%s (broken)", gLevelList[i].name.c_str()),
+                     r.x + 20, r.y + 12, 24, MAROON);
+            continue;
+        }
+
         if (!gLevelList[i].known) {
             DrawRectangleRec(r, Color{20, 20, 20, 180});
             DrawText("???", r.x + 20, r.y + 12, 24, DARKGRAY);
             continue;
         }
 
-        if (DrawMenuButton(gLevelList[i].name.c_str(), r)) {
+        if (DrawMenuButton(gLevelList[i].name.c_str(), r) &&
+                level.LoadFromFile(gLevelList[i].path)) {
             gameState = GameState::PLAYING;
 
-            level.LoadFromFile(gLevelList[i].path);
             InitializeFromLevel(&level, &view, &player, &hotbar);
             PlayerSyncVisual(&player, view);
 
@@ -363,12 +476,25 @@ void DrawLevelSelect(GameState& gameState,
             movementLocked = true;
 
             SoundRestartMusic();
-
-            UnloadRenderTexture(target);
-            target = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
-            UINoiseOnResize();
         }
 
+        // minimap, fitted into a square at the left end of the row
+        const Texture2D* thumb = ThumbnailGet(gLevelList[i].path, gLevelList[i].mtime);
+        if (thumb) {
+            float box = bh - 8;
+            float scale = std::min(box / thumb->width, box / thumb->height);
+            float tw = thumb->width * scale;
+            float th = thumb->height * scale;
+
+            DrawTexturePro(
+                *thumb,
+                Rectangle{ 0, 0, (float)thumb->width, (float)thumb->height },
+                Rectangle{ r.x + 4 + (box - tw) / 2, r.y + 4 + (box - th) / 2, tw, th },
+                Vector2{ 0, 0 },
+                0.0f,
+                WHITE
+            );
+        }
     }
 
     DrawRectangle(0, 0, GetScreenWidth(), SCREEN_HEIGHT / 3.0f, Fade(BLACK, 0.7f));
@@ -391,6 +517,261 @@ void DrawLevelSelect(GameState& gameState,
 
 
 
+// ------------------------------------------------------------
+// Scene rendering, shared by the game loop and --headless
+// ------------------------------------------------------------
+
+// ------------------------------------------------------------
+// Render snapshot. Drawing only ever reads this copy, so when pipelined
+// the next simulation step can run while the last one is on screen.
+// ------------------------------------------------------------
+
+struct RenderSnapshot {
+    Level level;            // only re-copied when the level or its tiles change
+    int epoch = -1;
+    int revision = -1;
+
+    View view;
+    Player player;
+    Hotbar hotbar;
+    bool isDead = false;
+    DeathFlash deathFlash;
+    Particles noise;
+};
+
+// only while the simulation is idle
+void CaptureSnapshot(RenderSnapshot& s,
+                     const Level& level,
+                     const View& view,
+                     const Player& player,
+                     const Hotbar& hotbar,
+                     bool isDead,
+                     const DeathFlash& deathFlash)
+{
+    PROFILE_FRAME_SCOPE("Snapshot");
+
+    if (s.epoch != gLevelEpoch || s.revision != level.world.revision) {
+        s.level = level;
+        s.epoch = gLevelEpoch;
+        s.revision = level.world.revision;
+    }
+
+    s.view = view;
+    s.player = player;
+    s.hotbar = hotbar;
+    s.isDead = isDead;
+    s.deathFlash = deathFlash;
+    s.noise = UINoiseParticles();
+}
+
+// Everything that goes into the internal framebuffer
+void RenderScene(PooledTarget& target, RenderSnapshot& snap)
+{
+    const Level& level = snap.level;
+    const View& view = snap.view;
+    const Player& player = snap.player;
+    const Hotbar& hotbar = snap.hotbar;
+    const DeathFlash& deathFlash = snap.deathFlash;
+    bool isDead = snap.isDead;
+
+    // tile clips all run off the shared clock, resolve them once up front
+    AnimUpdate(ClockTime());
+
+    // level changes can move the pixel scale too
+    SyncRenderTarget(target, view);
+    {
+        PROFILE_GPU_SCOPE("World layer rebuild");
+        UpdateWorldLayer(level.world, view, snap.epoch);
+    }
+    {
+        PROFILE_GPU_SCOPE("Hotbar rebuild");
+        HotbarPrepare(&hotbar, view);
+    }
+
+    BeginTextureMode(target.rt);
+    ClearBackground(BLACK);
+
+    DrawWorldCached(level.world, view);
+
+    if (!isDead) {
+        PROFILE_GPU_SCOPE("PlayerDraw");
+        PlayerDraw(&player, view);
+    }
+
+    // --- Death flash ---
+    if (deathFlash.active && deathFlash.timer < DEATH_FLASH_DURATION) {
+        float phase = sinf(deathFlash.timer * 20.0f);
+        float alpha = phase > 0 ? 1.0f : 0.6f;
+
+        Vector2 pos = view.GridToWorld(deathFlash.gx, deathFlash.gy);
+        DrawRectangle(
+                (int)pos.x,
+                (int)pos.y,
+                view.tileSize,
+                view.tileSize,
+                Fade(RED, alpha)
+                );
+    }
+
+    {
+        PROFILE_GPU_SCOPE("HotbarDraw");
+        HotbarDraw(&hotbar, player.maskUses, view);
+    }
+    {
+        PROFILE_GPU_SCOPE("UINoiseDraw");
+        UINoiseDraw(view, snap.noise);
+    }
+    {
+        PROFILE_GPU_SCOPE("Level texts");
+        TextBatchBegin();
+        for (const auto& t : level.texts) {
+            Vector2 pos = view.GridToWorld(t.gx, t.gy);
+            TextBatchDraw(t.text.c_str(), pos.x, pos.y,
+                    view.tileSize / 4, RAYWHITE);
+        }
+        TextBatchFlush();
+    }
+
+    EndTextureMode();
+}
+
+// Upscale + CRT into whatever is bound, the window or a capture target
+void DrawCRTPass(const PooledTarget& target, const View& view) {
+    PROFILE_GPU_SCOPE("CRT pass");
+
+    PostFXBegin(Vector2{ (float)GetScreenWidth(), (float)GetScreenHeight() },
+                RTPoolRegion(target));
+
+    DrawTexturePro(
+            target.rt.texture,
+            RTPoolSource(target),
+            UpscaledRect(view),
+            Vector2{ 0, 0 },
+            0.0f,
+            WHITE
+            );
+
+    PostFXEnd();
+}
+
+// ------------------------------------------------------------
+// Headless: scripted frames per level, PNG dumps and a timing report
+// ------------------------------------------------------------
+
+bool ScriptedDirection(char c, int& dx, int& dy) {
+    dx = dy = 0;
+    switch (c) {
+        case 'U': case 'u': dy = -1; return true;
+        case 'D': case 'd': dy =  1; return true;
+        case 'L': case 'l': dx = -1; return true;
+        case 'R': case 'r': dx =  1; return true;
+        default: return false;
+    }
+}
+
+int RunHeadless(HeadlessOptions& opt, Level& level, View& view, Player& player) {
+    HeadlessResolveLevels(opt);
+
+    PostFXInit();
+    UINoiseInit();
+
+    Hotbar hotbar;
+    RenderSnapshot snapshot;
+    PooledTarget target;
+    PooledTarget capture;   // CRT output for the PNG dumps
+
+    const float dt = 1.0f / TARGET_FPS;
+    std::vector<HeadlessResult> results;
+
+    for (const auto& path : opt.levels) {
+        HeadlessResult r;
+        r.path = path;
+
+        r.loaded = level.LoadFromFile(path);
+        if (!r.loaded) {
+            results.push_back(r);
+            continue;
+        }
+
+        InitializeFromLevel(&level, &view, &player, &hotbar);
+        PlayerSyncVisual(&player, view);
+
+        // same noise text every run
+        RngSeed(RngGet(RNG_UI), opt.seed ? opt.seed : 1);
+        UINoiseOnMaskChanged(MASK_NONE);
+
+        bool isDead = false;
+        DeathFlash deathFlash;
+        size_t nextMove = 0;
+
+        for (int frame = 0; frame < opt.frames; frame++) {
+            ClockSetFixed(frame * dt);
+            double start = GetTime();
+
+            if (!isDead) {
+                // scripted, the hotbar keys are never pressed
+                HotbarUpdate(&hotbar, dt, &(player.maskUses), player.moving, -1);
+                player.mask = HotbarGetSelectedMask(&hotbar);
+
+                int dx, dy;
+                while (!player.moving && nextMove < opt.moves.size()) {
+                    if (!ScriptedDirection(opt.moves[nextMove++], dx, dy)) continue;
+                    PlayerTryMove(&player, dx, dy, level.world, view);
+                    break;
+                }
+
+                PlayerUpdate(&player, dt, level.world, view);
+
+                if (!PlayerShouldBeAlive(&player, level.world)) {
+                    isDead = true;
+                    player.moving = false;
+                }
+            }
+
+            UINoiseUpdate(dt);
+            UINoiseOnMaskChanged(player.mask);
+
+            CaptureSnapshot(snapshot, level, view, player, hotbar, isDead, deathFlash);
+            RenderScene(target, snapshot);
+
+            BeginDrawing();
+            ClearBackground(BLACK);
+            DrawCRTPass(target, view);
+            EndDrawing();
+
+            r.frameMs.push_back((float)((GetTime() - start) * 1000.0));
+            r.seconds += GetTime() - start;
+            r.frames++;
+
+            bool last = frame == opt.frames - 1;
+            if (last || (opt.dumpEvery > 0 && frame % opt.dumpEvery == 0)) {
+                RTPoolResize(capture, GetScreenWidth(), GetScreenHeight());
+                BeginTextureMode(capture.rt);
+                ClearBackground(BLACK);
+                DrawCRTPass(target, view);
+                EndTextureMode();
+
+                std::string out = HeadlessDumpPath(opt, path, frame);
+                if (HeadlessExport(capture, out))
+                    r.dumps.push_back(out);
+            }
+        }
+
+        results.push_back(r);
+    }
+
+    ClockClearFixed();
+
+    RTPoolRelease(target);
+    RTPoolRelease(capture);
+    RTPoolRelease(gWorldLayer.target);
+    HotbarShutdown();
+    RTPoolShutdown();
+    PostFXShutdown();
+
+    return HeadlessReport(opt, results);
+}
+
 // ------------------------------------------------------------
 // ALL HAIL THE GREAT RESET 
 // ------------------------------------------------------------
@@ -400,12 +781,13 @@ void ResetGameplayState(
     View& view,
     Player& player,
     Hotbar& hotbar,
-    RenderTexture2D& target,
     bool& isDead,
     float& deathTimer,
     DeathFlash& deathFlash, 
     bool& movementLocked
 ) {
+    PROFILE_SCOPE("ResetGameplayState");
+
     level.LoadFromFile(START_LEVEL);
     InitializeFromLevel(&level, &view, &player, &hotbar);
     PlayerSyncVisual(&player, view);
@@ -423,11 +805,6 @@ void ResetGameplayState(
 
     view.Recalculate();
     PlayerSyncVisual(&player, view);
-
-    UnloadRenderTexture(target);
-    target = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
-
-    UINoiseOnResize();
 }
 
 // ------------------------------------------------------------
@@ -436,81 +813,317 @@ void ResetGameplayState(
 
 static MaskType lastMask = MASK_NONE;
 
-int main() {
+// ------------------------------------------------------------
+// One gameplay step. Runs on the sim thread when pipelined, so it only
+// gets input through SimInput and never draws.
+// ------------------------------------------------------------
+
+struct SimInput {
+    int hotbarSlot = -1;
+    bool anyMovementKey = false;
+    bool held = false;
+    int dx = 0;
+    int dy = 0;
+
+    // for level loads, GetScreenWidth isn't safe off the main thread
+    int windowW = 0;
+    int windowH = 0;
+};
+
+struct SimFrame {
+    Level* level;
+    View* view;
+    Player* player;
+    Hotbar* hotbar;
+    bool* isDead;
+    float* deathTimer;
+    DeathFlash* deathFlash;
+    bool* movementLocked;
+
+    float dt = 0.0f;
+    SimInput input;
+};
+
+// raylib input is main thread only
+SimInput SampleSimInput() {
+    SimInput in;
+    in.hotbarSlot = HotbarPressedSlot();
+    in.anyMovementKey = AnyMovementKeyDown();
+    in.held = GetHeldDirection(in.dx, in.dy);
+    in.windowW = GetScreenWidth();
+    in.windowH = GetScreenHeight();
+    return in;
+}
+
+static void SimulateFrame(void* arg) {
+    SimFrame& f = *(SimFrame*)arg;
+
+    Level& level = *f.level;
+    View& view = *f.view;
+    Player& player = *f.player;
+    Hotbar& hotbar = *f.hotbar;
+    bool& isDead = *f.isDead;
+    float& deathTimer = *f.deathTimer;
+    DeathFlash& deathFlash = *f.deathFlash;
+    bool& movementLocked = *f.movementLocked;
+
+    const SimInput& in = f.input;
+    const float dt = f.dt;
+
+    // ----------------------------------------------------
+    // Death timers
+    // ----------------------------------------------------
+
+    if (deathFlash.active) {
+        deathFlash.timer += dt;
+    }
+
+    if (isDead) {
+        deathTimer += dt;
+        if (deathTimer >= DEATH_SCREEN_DURATION) {
+            level.LoadFromFile(level.currentPath);
+            SaveRememberLevel(level.currentPath);
+            InitializeFromLevel(&level, &view, &player, &hotbar, in.windowW, in.windowH);
+
+            isDead = false;
+            movementLocked = true;
+            deathFlash.active = false;
+
+            player.moving = false;
+            player.slideDir = { 0, 0 };
+            SoundRestartMusic();
+        }
+    }
+
+    // ----------------------------------------------------
+    // Gameplay (only if alive)
+    // ----------------------------------------------------
+
+    if (!isDead) {
+        gAttempt.time += dt;
+        HotbarUpdate(&hotbar, dt, &(player.maskUses), player.moving, in.hotbarSlot);
+        player.mask = HotbarGetSelectedMask(&hotbar);
+
+
+        if (movementLocked) {
+            if (!in.anyMovementKey) {
+                movementLocked = false;
+            }
+        }
+
+        if (player.mask != lastMask) {
+            SoundOnMaskSwitch(player.mask);
+            lastMask = player.mask;
+        }
+
+        if (!player.moving && !movementLocked) {
+            if (in.held) {
+                PlayerTryMove(&player, in.dx, in.dy, level.world, view);
+                if (player.moving) gAttempt.moves++;
+            }
+        }
+
+        PlayerUpdate(&player, dt, level.world, view);
+
+        if (!PlayerShouldBeAlive(&player, level.world)) {
+            deathFlash.timer = 0.0f;
+            deathFlash.active = false;
+            deathFlash.reason = DeathReason::NONE;
+
+            // Determine cause
+            if (player.maskUses <= 0) {
+                deathFlash.reason = DeathReason::MASK_CONSUMED;
+                // no flash
+            } else {
+                Tile t = level.world.Get(player.gx, player.gy);
+                if (t == TILE_PIT) {
+                    deathFlash.reason = DeathReason::PIT;
+                } else if (t == TILE_FLAME) {
+                    deathFlash.reason = DeathReason::FLAME;
+                }
+
+                // only spatial deaths get a flash
+                if (deathFlash.reason != DeathReason::MASK_CONSUMED) {
+                    deathFlash.active = true;
+                    deathFlash.gx = player.gx;
+                    deathFlash.gy = player.gy;
+                }
+            }
+
+            isDead = true;
+            deathTimer = 0.0f;
+            movementLocked = true;
+
+            player.moving = false;
+            player.slideDir = { 0, 0 };
+
+
+            SoundOnDeath();
+            SaveRecordDeath(level.currentPath);
+        }
+
+        if (!player.moving) {
+            Tile t = level.world.Get(player.gx, player.gy);
+            if (t == TILE_GOAL && !gAttempt.cleared) {
+                gAttempt.cleared = true;
+                SaveRecordClear(level.currentPath, gAttempt.moves,
+                                gAttempt.time, player.maskUses);
+            }
+
+            if (t == TILE_GOAL && LevelHasNext(level)) {
+                if (level.LoadFromFile(level.nextLevelPath)) {
+                    InitializeFromLevel(&level, &view, &player, &hotbar, in.windowW, in.windowH);
+                    SaveRememberLevel(level.currentPath);
+                }
+            }
+            else if (t == TILE_PRESSUREPLATE && player.mask != MASK_WIND) {
+                level.world.ActivatePlate(player.gx, player.gy);
+                SoundOnPlate();
+            }
+        }
+    }
+
+    UINoiseUpdate(dt);
+    UINoiseOnMaskChanged(player.mask);
+}
+
+
+int main(int argc, char** argv) {
+    HeadlessOptions headless;
+    if (!HeadlessParseArgs(argc, argv, headless)) return 2;
+
     std::filesystem::current_path(
         std::filesystem::path(GetApplicationDirectory())
     );
 
+    RngSeedAll(headless.seed);
+
+    // no window at all, just the mixer against a null device
+    if (headless.audioLoopback) return AudioLoopbackRun(headless.audioBuffer);
+
+    ProfileInit(headless.profile);
+    ProfileBegin("Startup");
+
     Level level;
     level.LoadFromFile(START_LEVEL);
 
     View view;
     Player player;
 
-    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT + UI_HEIGHT,
-            "Highkey The Best Game You've Every Played");
-    SetWindowState(FLAG_WINDOW_RESIZABLE);
-    SetWindowState(FLAG_WINDOW_UNDECORATED);
-    SetWindowMinSize(SCREEN_WIDTH / 2, (SCREEN_HEIGHT + UI_HEIGHT) / 2);
-    MaximizeWindow();
+    ProfileBegin("InitWindow");
+    if (headless.enabled) {
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+        InitWindow(headless.width, headless.height, "Formless (headless)");
+    } else {
+        InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT + UI_HEIGHT,
+                "Highkey The Best Game You've Every Played");
+        SetWindowState(FLAG_WINDOW_RESIZABLE);
+        SetWindowState(FLAG_WINDOW_UNDECORATED);
+        SetWindowMinSize(SCREEN_WIDTH / 2, (SCREEN_HEIGHT + UI_HEIGHT) / 2);
+        MaximizeWindow();
+    }
+    ProfileEnd();
 
-    SetTargetFPS(TARGET_FPS);
+    // uncapped in headless, we want to know how fast it can go
+    SetTargetFPS(headless.enabled ? 0 : TARGET_FPS);
     SetExitKey(KEY_NULL);
 
-    LoadTileTextures();
-    InitMaskAnimations();
-    SaveInit();
+    {
+        PROFILE_SCOPE("LoadTileTextures");
+        LoadTileTextures();
+    }
+    {
+        PROFILE_SCOPE("AnimInit");
+        AnimInit(ANIM_FILE);
+        InitMaskAnimations();
+    }
+
+    if (headless.enabled) {
+        ProfileEnd();  // Startup
+
+        int rc = RunHeadless(headless, level, view, player);
+
+        FrameProfShutdown();
+        UnloadTileTextures();
+        AnimShutdown();
+        CloseWindow();
+        ProfileShutdown();
+        return rc;
+    }
+
+    PacerInit();
+    {
+        PROFILE_SCOPE("SaveInit");
+        SaveInit();
+    }
+    CatalogueInit();
+    ThumbnailInit();
 
     Hotbar hotbar;
     InitializeFromLevel(&level, &view, &player, &hotbar);
     SaveRememberLevel(level.currentPath);
     PlayerSyncVisual(&player, view);
 
-    RenderTexture2D target = LoadRenderTexture(
-            GetScreenWidth(),
-            GetScreenHeight()
-            );
+    PooledTarget target;
+    SyncRenderTarget(target, view);
+
+    // CRT'd copy of the last gameplay frame, shown behind the pause menu
+    PooledTarget pauseFrame;
+    bool pauseFrameValid = false;
 
-    Shader crtShader = LoadShader(0, "assets/shaders/crt.fs");
-
-    int timeLoc      = GetShaderLocation(crtShader, "time");
-    int curvatureLoc = GetShaderLocation(crtShader, "curvature");
-    int scanlineLoc  = GetShaderLocation(crtShader, "scanlineIntensity");
-    int vignetteLoc  = GetShaderLocation(crtShader, "vignette");
-    int ditherLoc    = GetShaderLocation(crtShader, "ditherStrength");
-    int resLoc       = GetShaderLocation(crtShader, "resolution");
-    int chromLoc     = GetShaderLocation(crtShader, "chromAberration");
-    int jitterLoc    = GetShaderLocation(crtShader, "jitterStrength");
-    int jitterSpdLoc = GetShaderLocation(crtShader, "jitterSpeed");
-
-    SetShaderValue(crtShader, curvatureLoc, &CRT_CURVATURE, SHADER_UNIFORM_FLOAT);
-    SetShaderValue(crtShader, scanlineLoc,  &CRT_SCANLINE_INTENSITY, SHADER_UNIFORM_FLOAT);
-    SetShaderValue(crtShader, vignetteLoc,  &CRT_VIGNETTE, SHADER_UNIFORM_FLOAT);
-    SetShaderValue(crtShader, ditherLoc,    &DITHER_STRENGTH, SHADER_UNIFORM_FLOAT);
-    SetShaderValue(crtShader, chromLoc,     &CHROM_ABERRATION, SHADER_UNIFORM_FLOAT);
-    SetShaderValue(crtShader, jitterLoc,    &JITTER_STRENGTH, SHADER_UNIFORM_FLOAT);
-    SetShaderValue(crtShader, jitterSpdLoc, &JITTER_SPEED, SHADER_UNIFORM_FLOAT);
+    {
+        PROFILE_SCOPE("PostFXInit");
+        PostFXInit();
+    }
 
     bool isDead = false;
     bool movementLocked = false;
     float deathTimer = 0.0f;
     DeathFlash deathFlash;
 
+    SimFrame sim{ &level, &view, &player, &hotbar,
+                  &isDead, &deathTimer, &deathFlash, &movementLocked,
+                  0.0f, SimInput{} };
+    RenderSnapshot snapshot;
+
     UINoiseInit();
 
 
-    SoundInit();
+    {
+        PROFILE_SCOPE("SoundInit");
+        MixerSetBufferFrames(headless.audioBuffer);
+        SoundInit();
+    }
+    SimThreadInit(headless.pipelined);
+    const bool pipelined = SimThreadPipelined();
+
     GameState gameState = GameState::MENU;
-    InitMenuQuotes();
+    MenuQuotesInit();
+
+    ProfileEnd();  // Startup
+    bool firstFrame = true;
 
     // --------------------------------------------------------
     // Game loop
     // --------------------------------------------------------
 
     while (!WindowShouldClose()) {
-        SoundUpdate();
+        PostFXFrameBegin();
         float dt = GetFrameTime();
+        PacerFrameBegin();
+        FrameProfBegin(dt);
+
+        // everything below may touch the game state, the step from the last
+        // frame has to be done with it first
+        {
+            PROFILE_FRAME_SCOPE("Simulation wait");
+            SimThreadWait();
+        }
 
+        UpdateResize(dt, view, player);
+        UpdateIdle(dt, gResizeTimer > 0.0f ||
+                       (gameState == GameState::PLAYING &&
+                        (player.moving || isDead || deathFlash.active)));
 
         if (IsKeyPressed(KEY_ESCAPE)) {
             if (gameState == GameState::PLAYING) {
@@ -522,6 +1135,9 @@ int main() {
             else if (gameState == GameState::PAUSED) {
                 gameState = GameState::PLAYING;
                 DisableCursor();
+
+                pauseFrameValid = false;
+                RTPoolRelease(pauseFrame);
             }
         }
 
@@ -531,7 +1147,6 @@ int main() {
                     view,
                     player,
                     hotbar,
-                    target,
                     isDead,
                     deathTimer,
                     deathFlash,
@@ -541,19 +1156,26 @@ int main() {
 
 
         if (gameState == GameState::PAUSED) {
+            // the frame behind the menu is frozen, run the CRT pass over it
+            // once and just blit the result until something invalidates it
+            int w = GetScreenWidth();
+            int h = GetScreenHeight();
+            if (!pauseFrameValid || pauseFrame.width != w || pauseFrame.height != h) {
+                RTPoolResize(pauseFrame, w, h);
+
+                BeginTextureMode(pauseFrame.rt);
+                ClearBackground(BLACK);
+                DrawCRTPass(target, view);
+                EndTextureMode();
+
+                pauseFrameValid = true;
+            }
+
             BeginDrawing();
             ClearBackground(BLACK);
 
-            BeginShaderMode(crtShader);
-            DrawTexturePro(
-                    target.texture,
-                    Rectangle{ 0, 0, (float)target.texture.width, -(float)target.texture.height },
-                    Rectangle{ 0, 0, (float)GetScreenWidth(), (float)GetScreenHeight() },
-                    Vector2{ 0, 0 },
-                    0.0f,
-                    WHITE
-                    );
-            EndShaderMode();
+            DrawTextureRec(pauseFrame.rt.texture, RTPoolSource(pauseFrame),
+                           Vector2{ 0, 0 }, WHITE);
 
             bool resume = false;
             bool restart = false;
@@ -563,6 +1185,11 @@ int main() {
 
             EndDrawing();
 
+            if (resume || restart || toMenu) {
+                pauseFrameValid = false;
+                RTPoolRelease(pauseFrame);
+            }
+
             if (resume) {
                 gameState = GameState::PLAYING;
                 DisableCursor();
@@ -592,7 +1219,7 @@ int main() {
 
                 SoundStopMovement();
                 SoundRestartMusic();
-                InitMenuQuotes();
+                MenuQuotesRestart();
             }
 
             continue;
@@ -604,7 +1231,7 @@ int main() {
             BeginDrawing();
             ClearBackground(BLACK);
 
-            DrawMenuFloatingText(dt);
+            MenuQuotesDraw();
 
             DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), Fade(BLACK, 0.6f));
 
@@ -633,13 +1260,14 @@ int main() {
                 gameState = GameState::PLAYING;
 
                 ResetGameplayState(
-                        level, view, player, hotbar, target,
+                        level, view, player, hotbar,
                         isDead, deathTimer, deathFlash,
                         movementLocked
                         );
             }
 
             if (DrawMenuButton("LEVEL SELECT", levelSelectBtn)) {
+                CatalogueRefresh();
                 LoadLevelList();
                 gameState = GameState::LEVEL_SELECT;
             }
@@ -649,6 +1277,11 @@ int main() {
             }
 
             EndDrawing();
+
+            if (firstFrame) {
+                ProfileMark("First interactive frame");
+                firstFrame = false;
+            }
             continue; 
         }
 
@@ -656,207 +1289,56 @@ int main() {
 
         HideCursor();
 
-        // --- Resize ---
-        if (IsWindowResized()) {
+        // --- Quality controller wants a different internal resolution ---
+        // (wait until the player stands still, the resync snaps them to the grid)
+        if (view.downscale != PostFXResolutionDivisor() && !player.moving) {
+            view.downscale = PostFXResolutionDivisor();
             view.Recalculate();
             PlayerSyncVisual(&player, view);
-
-            UnloadRenderTexture(target);
-            target = LoadRenderTexture(
-                    GetScreenWidth(),
-                    GetScreenHeight()
-                    );
-
-            UINoiseOnResize();
         }
 
-        // ----------------------------------------------------
-        // Death timers
-        // ----------------------------------------------------
+        // pipelined: draw what the last step left while the next one runs,
+        // inline: step first so the frame isn't a step behind
+        if (pipelined)
+            CaptureSnapshot(snapshot, level, view, player, hotbar, isDead, deathFlash);
 
-        if (deathFlash.active) {
-            deathFlash.timer += dt;
+        sim.dt = dt;
+        sim.input = SampleSimInput();
+        {
+            PROFILE_FRAME_SCOPE("Simulation");
+            SimThreadRun(SimulateFrame, &sim);
         }
 
-        if (isDead) {
-            deathTimer += dt;
-            if (deathTimer >= DEATH_SCREEN_DURATION) {
-                level.LoadFromFile(level.currentPath);
-                SaveRememberLevel(level.currentPath);
-                InitializeFromLevel(&level, &view, &player, &hotbar);
-
-                isDead = false;
-                movementLocked = true;
-                deathFlash.active = false;
-
-                player.moving = false;
-                player.slideDir = { 0, 0 };
-                SoundRestartMusic();
-            }
-        }
-
-        // ----------------------------------------------------
-        // Gameplay (only if alive)
-        // ----------------------------------------------------
-
-        if (!isDead) {
-            HotbarUpdate(&hotbar, dt, &(player.maskUses), player.moving);
-            player.mask = HotbarGetSelectedMask(&hotbar);
-
-
-            if (movementLocked) {
-                if (!AnyMovementKeyDown()) {
-                    movementLocked = false;
-                }
-            }
-
-            if (player.mask != lastMask) {
-                SoundOnMaskSwitch(player.mask);
-                lastMask = player.mask;
-            }
-
-            if (!player.moving && !movementLocked) {
-                int dx, dy;
-                if (GetHeldDirection(dx, dy)) {
-                    PlayerTryMove(&player, dx, dy, level.world, view);
-                }
-            }
-
-            PlayerUpdate(&player, dt, level.world, view);
-
-            if (!PlayerShouldBeAlive(&player, level.world)) {
-                deathFlash.timer = 0.0f;
-                deathFlash.active = false;
-                deathFlash.reason = DeathReason::NONE;
-
-                // Determine cause
-                if (player.maskUses <= 0) {
-                    deathFlash.reason = DeathReason::MASK_CONSUMED;
-                    // no flash
-                } else {
-                    Tile t = level.world.Get(player.gx, player.gy);
-                    if (t == TILE_PIT) {
-                        deathFlash.reason = DeathReason::PIT;
-                    } else if (t == TILE_FLAME) {
-                        deathFlash.reason = DeathReason::FLAME;
-                    }
-
-                    // only spatial deaths get a flash
-                    if (deathFlash.reason != DeathReason::MASK_CONSUMED) {
-                        deathFlash.active = true;
-                        deathFlash.gx = player.gx;
-                        deathFlash.gy = player.gy;
-                    }
-                }
-
-                isDead = true;
-                deathTimer = 0.0f;
-                movementLocked = true;
-
-                player.moving = false;
-                player.slideDir = { 0, 0 };
-
-
-                SoundOnDeath();
-            }
-
-            if (!player.moving) {
-                Tile t = level.world.Get(player.gx, player.gy);
-                if (t == TILE_GOAL && LevelHasNext(level)) {
-                    if (level.LoadFromFile(level.nextLevelPath)) {
-                        InitializeFromLevel(&level, &view, &player, &hotbar);
-                        SaveRememberLevel(level.currentPath);
-                    }
-                }
-                else if (t == TILE_PRESSUREPLATE && player.mask != MASK_WIND) {
-                    level.world.ActivatePlate(player.gx, player.gy);
-                    SoundOnPlate();
-                }
-            }
-        }
-
-        UINoiseUpdate(dt);
-        UINoiseOnMaskChanged(player.mask);
+        if (!pipelined)
+            CaptureSnapshot(snapshot, level, view, player, hotbar, isDead, deathFlash);
 
         // ----------------------------------------------------
         // Render to texture
         // ----------------------------------------------------
 
-        BeginTextureMode(target);
-        ClearBackground(BLACK);
-
-        level.world.Draw(view);
-        level.world.DrawOutlines(view);
-
-        if (!isDead)
-            PlayerDraw(&player, view);
-
-        // --- Death flash ---
-        if (deathFlash.active && deathFlash.timer < DEATH_FLASH_DURATION) {
-            float phase = sinf(deathFlash.timer * 20.0f);
-            float alpha = phase > 0 ? 1.0f : 0.6f;
-
-            Vector2 pos = view.GridToWorld(deathFlash.gx, deathFlash.gy);
-            DrawRectangle(
-                    (int)pos.x,
-                    (int)pos.y,
-                    view.tileSize,
-                    view.tileSize,
-                    Fade(RED, alpha)
-                    );
-        }
-
-        HotbarDraw(&hotbar, player.maskUses);
-        UINoiseDraw();
-
-        for (const auto& t : level.texts) {
-            Vector2 pos = view.GridToWorld(t.gx, t.gy);
-            DrawText(t.text.c_str(), pos.x, pos.y,
-                    view.tileSize / 4, RAYWHITE);
-        }
-
-        EndTextureMode();
+        PostFXGpuBegin();
+        RenderScene(target, snapshot);
 
         // ----------------------------------------------------
         // Final draw
         // ----------------------------------------------------
 
-        float time = GetTime();
-        SetShaderValue(crtShader, timeLoc, &time, SHADER_UNIFORM_FLOAT);
-
-        Vector2 res = { (float)GetScreenWidth(), (float)GetScreenHeight() };
-        SetShaderValue(crtShader, resLoc, &res, SHADER_UNIFORM_VEC2);
-
         BeginDrawing();
         ClearBackground(BLACK);
 
-#if ENABLE_CRT
-        BeginShaderMode(crtShader);
-#endif
-
-        DrawTexturePro(
-                target.texture,
-                Rectangle{ 0, 0, (float)target.texture.width, -(float)target.texture.height },
-                Rectangle{ 0, 0, (float)GetScreenWidth(), (float)GetScreenHeight() },
-                Vector2{ 0, 0 },
-                0.0f,
-                WHITE
-                );
-
-#if ENABLE_CRT
-        EndShaderMode();
-#endif
+        DrawCRTPass(target, snapshot.view);
+        PostFXGpuEnd();
 
         // --- YOU DIED (after flash) ---
-        if (isDead && 
-                (deathFlash.timer >= DEATH_FLASH_DURATION 
-                 || !deathFlash.active)) {
+        if (snapshot.isDead &&
+                (snapshot.deathFlash.timer >= DEATH_FLASH_DURATION
+                 || !snapshot.deathFlash.active)) {
             DrawRectangle(0, 0,
                     GetScreenWidth(),
                     GetScreenHeight(),
                     Fade(BLACK, 0.4f));
 
-            const char* msg = DeathText(deathFlash.reason);
+            const char* msg = DeathText(snapshot.deathFlash.reason);
             int fontSize = GetScreenWidth() / 12;
             int textWidth = MeasureText(msg, fontSize);
 
@@ -869,12 +1351,31 @@ int main() {
                     );
         }
 
+        FrameProfDrawOverlay();
+
+        // a throttled frame would look like a missed one to the controller
+        if (!gIdle) PostFXFrameEnd(dt);
+        PacerFrameEnd();
         EndDrawing();
     }
 
+    SimThreadShutdown();
+    ThumbnailShutdown();
+    CatalogueShutdown();
+    SaveShutdown();
+    RTPoolRelease(target);
+    RTPoolRelease(pauseFrame);
+    RTPoolRelease(gWorldLayer.target);
+    HotbarShutdown();
+    RTPoolShutdown();
+    PostFXShutdown();
+    FrameProfShutdown();
+    MenuQuotesShutdown();
     UnloadTileTextures();
+    AnimShutdown();
     CloseWindow();
 
     SoundShutdown();
+    ProfileShutdown();
     return 0;
 }
@@ -0,0 +1,411 @@
+// levellint - validates every level under levels/ in parallel.
+//
+//   make lint
+//   ./levellint [root] [--json] [-j N]
+//
+// Diagnostics go to stdout, one per line, either gcc style
+//   levels/foo.txt:12:5: error: [world-width] ...
+// or as JSON lines with --json. Exit code is 1 if any error was found.
+//
+// Mirrors the grammar of Level::LoadFromFile but never stops at the first
+// problem, and knows nothing about raylib so it builds anywhere.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+enum Severity { SEV_WARNING, SEV_ERROR };
+
+struct Diagnostic {
+    int line;
+    int col;
+    Severity severity;
+    const char* code;
+    std::string message;
+};
+
+struct LevelReport {
+    std::string path;        // normalized, relative to root
+    std::string nextLevel;   // normalized, empty if none
+    int nextLine = 0;
+    std::vector<Diagnostic> diags;
+};
+
+static const char* KNOWN_TILES[] = {
+    "TILE_EMPTY", "TILE_WALL", "TILE_FLAME", "TILE_PIT", "TILE_GOAL",
+    "TILE_GLASS", "TILE_PRESSUREPLATE", "TILE_PRESSUREPLATE_USED",
+    "TILE_DOOR_CLOSED", "TILE_DOOR_OPEN"
+};
+
+static std::string NormalizePath(const std::string& path) {
+    std::string out = fs::path(path).lexically_normal().generic_string();
+    std::replace(out.begin(), out.end(), '\\', '/');
+    return out;
+}
+
+static bool IsKnownTile(const std::string& name) {
+    for (const char* t : KNOWN_TILES)
+        if (name == t) return true;
+    return false;
+}
+
+// -----------------------------
+// Per-file checks
+// -----------------------------
+
+static void LintFile(const fs::path& root, LevelReport& r) {
+    auto diag = [&](int line, int col, Severity sev, const char* code, std::string msg) {
+        r.diags.push_back({ line, col, sev, code, std::move(msg) });
+    };
+
+    std::ifstream file(root / r.path);
+    if (!file.is_open()) {
+        diag(0, 0, SEV_ERROR, "io", "cannot open file");
+        return;
+    }
+
+    enum Section { NONE, LEGEND, WORLD };
+    Section section = NONE;
+
+    std::unordered_map<char, std::string> legend;
+    std::vector<std::string> world;
+    std::vector<int> worldLineNo;
+
+    std::unordered_map<std::string, int> seenKeys;  // key -> first line
+    int spawnX = 0, spawnY = 0, spawnLine = 0;
+    std::string startMask;
+    struct Text { int gx, gy, line; };
+    std::vector<Text> texts;
+
+    std::string line;
+    int lineNo = 0;
+
+    while (std::getline(file, line)) {
+        lineNo++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        if (line == "LEGEND") { section = LEGEND; continue; }
+        if (line == "WORLD")  { section = WORLD;  continue; }
+        if (line == "END")    { section = NONE;   continue; }
+
+        std::stringstream ss(line);
+
+        if (section == LEGEND) {
+            char c;
+            std::string tileName;
+            if (!(ss >> c >> tileName)) {
+                diag(lineNo, 1, SEV_ERROR, "legend-syntax", "expected '<char> <TILE_NAME>'");
+                continue;
+            }
+            if (!IsKnownTile(tileName)) {
+                diag(lineNo, 3, SEV_ERROR, "legend-tile", "unknown tile '" + tileName + "'");
+                continue;
+            }
+            if (legend.count(c)) {
+                diag(lineNo, 1, SEV_WARNING, "legend-duplicate",
+                     std::string("'") + c + "' is already mapped to " + legend[c]);
+            }
+            legend[c] = tileName;
+        }
+        else if (section == WORLD) {
+            world.push_back(line);
+            worldLineNo.push_back(lineNo);
+        }
+        else {
+            std::string key;
+            ss >> key;
+
+            if (key != "TEXT") {
+                auto it = seenKeys.find(key);
+                if (it != seenKeys.end()) {
+                    diag(lineNo, 1, SEV_ERROR, "duplicate-key",
+                         key + " already set on line " + std::to_string(it->second));
+                }
+                else {
+                    seenKeys[key] = lineNo;
+                }
+            }
+
+            if (key == "SPAWN") {
+                if (!(ss >> spawnX >> spawnY)) {
+                    diag(lineNo, 1, SEV_ERROR, "spawn-syntax", "expected 'SPAWN <x> <y>'");
+                    seenKeys.erase(key);
+                }
+                spawnLine = lineNo;
+            }
+            else if (key == "START_MASK") {
+                ss >> startMask;
+                if (startMask != "MASK_WIND" && startMask != "MASK_STONE") {
+                    diag(lineNo, 12, SEV_ERROR, "start-mask",
+                         "START_MASK must be MASK_WIND or MASK_STONE, got '" + startMask + "'");
+                }
+            }
+            else if (key == "MASK_USES") {
+                int uses = 0;
+                if (!(ss >> uses) || uses <= 0) {
+                    diag(lineNo, 11, SEV_ERROR, "mask-uses", "MASK_USES must be a positive integer");
+                }
+            }
+            else if (key == "NEXT_LEVEL") {
+                std::string next;
+                ss >> next;
+                if (next.empty()) {
+                    diag(lineNo, 12, SEV_ERROR, "next-level", "NEXT_LEVEL without a path");
+                }
+                else {
+                    r.nextLevel = NormalizePath(next);
+                    r.nextLine = lineNo;
+                }
+            }
+            else if (key == "TEXT") {
+                Text t{ 0, 0, lineNo };
+                if (!(ss >> t.gx >> t.gy)) {
+                    diag(lineNo, 1, SEV_ERROR, "text-syntax", "expected 'TEXT <x> <y> <text>'");
+                    continue;
+                }
+                texts.push_back(t);
+            }
+            else {
+                diag(lineNo, 1, SEV_WARNING, "unknown-key", "unknown key '" + key + "'");
+            }
+        }
+    }
+
+    if (section != NONE)
+        diag(lineNo, 0, SEV_WARNING, "missing-end", "section not closed with END");
+
+    for (const char* key : { "SPAWN", "START_MASK", "MASK_USES" }) {
+        if (!seenKeys.count(key))
+            diag(0, 0, SEV_ERROR, "missing-key", std::string("missing ") + key);
+    }
+
+    // the game only complains about this when the player reaches the goal
+    if (!seenKeys.count("NEXT_LEVEL"))
+        diag(0, 0, SEV_WARNING, "missing-key", "missing NEXT_LEVEL, GOAL tiles lead nowhere");
+
+    // --- World ---
+    if (world.empty()) {
+        diag(0, 0, SEV_ERROR, "world-empty", "WORLD section is empty");
+        return;
+    }
+
+    int width = (int)world[0].size();
+    int height = (int)world.size();
+
+    for (size_t y = 0; y < world.size(); y++) {
+        const std::string& row = world[y];
+
+        if ((int)row.size() != width) {
+            diag(worldLineNo[y], 1, SEV_ERROR, "world-width",
+                 "row is " + std::to_string(row.size()) + " wide, expected " + std::to_string(width));
+        }
+
+        for (size_t x = 0; x < row.size(); x++) {
+            if (!legend.count(row[x])) {
+                diag(worldLineNo[y], (int)x + 1, SEV_ERROR, "world-char",
+                     std::string("'") + row[x] + "' is not in the LEGEND");
+            }
+        }
+    }
+
+    auto tileAt = [&](int x, int y) -> std::string {
+        if (y < 0 || y >= height || x < 0 || x >= (int)world[y].size()) return "";
+        auto it = legend.find(world[y][x]);
+        return it == legend.end() ? "TILE_EMPTY" : it->second;
+    };
+
+    // --- Spawn ---
+    if (seenKeys.count("SPAWN")) {
+        if (spawnX < 0 || spawnY < 0 || spawnX >= width || spawnY >= height) {
+            diag(spawnLine, 7, SEV_ERROR, "spawn-bounds",
+                 "spawn (" + std::to_string(spawnX) + ", " + std::to_string(spawnY) +
+                 ") is outside the " + std::to_string(width) + "x" + std::to_string(height) + " world");
+        }
+        else {
+            std::string t = tileAt(spawnX, spawnY);
+            if (t == "TILE_WALL" || t == "TILE_DOOR_CLOSED") {
+                diag(spawnLine, 7, SEV_ERROR, "spawn-solid", "spawn is on " + t);
+            }
+            else if ((t == "TILE_FLAME" && startMask != "MASK_STONE") ||
+                     (t == "TILE_PIT" && startMask != "MASK_WIND")) {
+                diag(spawnLine, 7, SEV_ERROR, "spawn-deadly",
+                     "spawn is on " + t + " with " + (startMask.empty() ? "no mask" : startMask));
+            }
+        }
+    }
+
+    for (const auto& t : texts) {
+        if (t.gx < 0 || t.gy < 0 || t.gx >= width || t.gy >= height)
+            diag(t.line, 6, SEV_WARNING, "text-bounds", "TEXT is anchored outside the world");
+    }
+}
+
+// -----------------------------
+// NEXT_LEVEL graph
+// -----------------------------
+
+static void LintGraph(const fs::path& root, std::vector<LevelReport>& reports) {
+    std::unordered_map<std::string, size_t> index;
+    for (size_t i = 0; i < reports.size(); i++)
+        index[reports[i].path] = i;
+
+    std::vector<int> next(reports.size(), -1);
+
+    for (size_t i = 0; i < reports.size(); i++) {
+        LevelReport& r = reports[i];
+        if (r.nextLevel.empty()) continue;
+
+        auto it = index.find(r.nextLevel);
+        if (it != index.end()) {
+            next[i] = (int)it->second;
+        }
+        else if (!fs::is_regular_file(root / r.nextLevel)) {
+            r.diags.push_back({ r.nextLine, 12, SEV_ERROR, "next-missing",
+                                "NEXT_LEVEL '" + r.nextLevel + "' does not exist" });
+        }
+    }
+
+    // every node has at most one edge, so walking with three colours finds
+    // each cycle exactly once
+    std::vector<int> state(reports.size(), 0);  // 0 new, 1 on current walk, 2 done
+
+    for (size_t start = 0; start < reports.size(); start++) {
+        std::vector<int> walk;
+        int n = (int)start;
+
+        while (n >= 0 && state[n] == 0) {
+            state[n] = 1;
+            walk.push_back(n);
+            n = next[n];
+        }
+
+        if (n >= 0 && state[n] == 1) {
+            auto from = std::find(walk.begin(), walk.end(), n);
+
+            std::string chain;
+            for (auto it = from; it != walk.end(); ++it)
+                chain += reports[*it].path + " -> ";
+            chain += reports[n].path;
+
+            LevelReport& r = reports[*std::min_element(from, walk.end(),
+                [&](int a, int b) { return reports[a].path < reports[b].path; })];
+            r.diags.push_back({ r.nextLine, 12, SEV_WARNING, "next-cycle",
+                                "NEXT_LEVEL chain loops: " + chain });
+        }
+
+        for (int w : walk) state[w] = 2;
+    }
+}
+
+// -----------------------------
+// Output
+// -----------------------------
+
+static std::string JsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n";  break;
+            case '\t': out += "\\t";  break;
+            default:
+                if ((unsigned char)c < 0x20) {
+                    char buf[8];
+                    snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    out += buf;
+                }
+                else {
+                    out += c;
+                }
+        }
+    }
+    return out;
+}
+
+static void Print(const LevelReport& r, const Diagnostic& d, bool json) {
+    const char* sev = d.severity == SEV_ERROR ? "error" : "warning";
+
+    if (json) {
+        printf("{\"file\":\"%s\",\"line\":%d,\"col\":%d,\"severity\":\"%s\",\"code\":\"%s\",\"message\":\"%s\"}\n",
+               JsonEscape(r.path).c_str(), d.line, d.col, sev, d.code, JsonEscape(d.message).c_str());
+    }
+    else {
+        printf("%s:%d:%d: %s: [%s] %s\n", r.path.c_str(), d.line, d.col, sev, d.code, d.message.c_str());
+    }
+}
+
+int main(int argc, char** argv) {
+    fs::path root = ".";
+    bool json = false;
+    unsigned int jobs = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--json") json = true;
+        else if (arg == "-j" && i + 1 < argc) jobs = std::max(1, atoi(argv[++i]));
+        else root = arg;
+    }
+
+    fs::path levelsDir = root / "levels";
+    if (!fs::is_directory(levelsDir)) {
+        fprintf(stderr, "levellint: '%s' not found\n", levelsDir.string().c_str());
+        return 2;
+    }
+
+    // top level only, same as the catalogue, the game never loads subfolders
+    std::vector<LevelReport> reports;
+    for (const auto& entry : fs::directory_iterator(levelsDir)) {
+        if (!entry.is_regular_file()) continue;
+        if (entry.path().extension() != ".txt") continue;
+
+        LevelReport r;
+        r.path = NormalizePath(fs::relative(entry.path(), root).string());
+        reports.push_back(std::move(r));
+    }
+
+    std::sort(reports.begin(), reports.end(),
+        [](const LevelReport& a, const LevelReport& b) { return a.path < b.path; });
+
+    // files are independent, hand them out to workers one at a time
+    std::atomic<size_t> cursor{0};
+    std::vector<std::thread> workers;
+    jobs = std::min<unsigned int>(jobs, std::max<size_t>(1, reports.size()));
+
+    for (unsigned int j = 0; j < jobs; j++) {
+        workers.emplace_back([&] {
+            for (size_t i; (i = cursor++) < reports.size(); )
+                LintFile(root, reports[i]);
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    LintGraph(root, reports);
+
+    int errors = 0, warnings = 0;
+    for (auto& r : reports) {
+        std::stable_sort(r.diags.begin(), r.diags.end(),
+            [](const Diagnostic& a, const Diagnostic& b) { return a.line < b.line; });
+
+        for (const auto& d : r.diags) {
+            Print(r, d, json);
+            (d.severity == SEV_ERROR ? errors : warnings)++;
+        }
+    }
+
+    fprintf(stderr, "levellint: %zu levels, %d errors, %d warnings\n",
+            reports.size(), errors, warnings);
+
+    return errors > 0 ? 1 : 0;
+}
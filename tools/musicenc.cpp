@@ -0,0 +1,39 @@
+// musicenc - re-encodes the soundtrack to QOA.
+//
+//   make music
+//   ./musicenc [in.wav] [out.qoa]
+//
+// QOA is raylib's built in lossy format, about 3.2 bits per sample and
+// nothing extra to link. Defaults to MUSIC_FILE_FALLBACK -> MUSIC_FILE.
+
+#include "config.h"
+#include <raylib.h>
+#include <cstdio>
+
+int main(int argc, char** argv) {
+    const char* in  = argc > 1 ? argv[1] : MUSIC_FILE_FALLBACK;
+    const char* out = argc > 2 ? argv[2] : MUSIC_FILE;
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    Wave wave = LoadWave(in);
+    if (!IsWaveValid(wave)) {
+        fprintf(stderr, "musicenc: can't read %s\n", in);
+        return 1;
+    }
+
+    // the QOA writer only takes 16 bit
+    if (wave.sampleSize != 16)
+        WaveFormat(&wave, wave.sampleRate, 16, wave.channels);
+
+    bool ok = ExportWave(wave, out);
+    UnloadWave(wave);
+
+    if (!ok) {
+        fprintf(stderr, "musicenc: can't write %s\n", out);
+        return 1;
+    }
+
+    printf("musicenc: %s -> %s (%d bytes)\n", in, out, GetFileLength(out));
+    return 0;
+}